@@ -0,0 +1,396 @@
+// -----------------------------------------------------------------------------
+//    Quadra Benchmark File:  instancescaling.cpp
+//
+/**
+    \file   instancescaling.cpp
+    \author Christian George
+    \date   01-June-2019
+    \brief  multi-instance scaling benchmark for PluginCore
+
+    		- creates N PluginCore instances and drives them from M threads,
+    		  one host-style processAudioBuffers( ) call per block
+    		- reports aggregate throughput (in real-time instances) and the
+    		  per-instance p99 block latency against the block deadline
+    		- sweeps the thread count to show the scaling efficiency, then runs
+    		  A/B diagnostics for the shared state that can limit scaling:
+    		  the global rand( ) state used by the S&H LFO (rand( ) against a
+    		  per-thread generator) and packed vs padded instance placement
+    		  (false sharing, flagged only when instances share a cache line)
+
+    		stand-alone console program; it is not part of the plugin project.
+    		build from the project root, e.g.
+
+    		MSVC:
+    		  cl /O2 /EHsc /DNDEBUG /I PluginKernel /I PluginObjects /I CustomControls
+    		     Benchmarks\instancescaling.cpp PluginKernel\pluginbase.cpp
+    		     PluginKernel\plugincore.cpp PluginKernel\pluginparameter.cpp
+    		     PluginObjects\fxobjects.cpp
+
+    		clang/gcc:
+    		  c++ -std=c++14 -O2 -DNDEBUG -pthread -IPluginKernel -IPluginObjects -ICustomControls
+    		      -include cstring -include algorithm Benchmarks/instancescaling.cpp
+    		      PluginKernel/pluginbase.cpp PluginKernel/plugincore.cpp
+    		      PluginKernel/pluginparameter.cpp PluginObjects/fxobjects.cpp
+
+    		usage: instancescaling [instances=32] [threads=hw] [seconds=2] [blockSize=256]
+*/
+// -----------------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <random>
+
+#include "plugincore.h"
+
+// --- benchmark constants
+const double kBenchSampleRate = 48000.0;
+const size_t kCacheLineSize = 64;
+const size_t kPaddedPlacement = 4096;	///< padded instances start on their own page
+const double kFlagThreshold = 0.10;		///< A/B differences above 10% are flagged
+
+/**
+\class NullMidiEventQueue
+\brief
+Empty MIDI queue; PluginCore only fires MIDI on the frames the shell flags, but a flagged frame needs a valid queue.
+*/
+class NullMidiEventQueue : public IMidiEventQueue
+{
+public:
+	virtual uint32_t getEventCount() { return 0; }
+	virtual bool fireMidiEvents(uint32_t) { return true; }
+};
+
+/**
+\struct BenchConfig
+\brief
+One benchmark run: instance/thread counts and the A/B switches.
+*/
+struct BenchConfig
+{
+	uint32_t instances = 32;
+	uint32_t threads = 1;
+	uint32_t blocks = 375;		///< blocks processed per instance
+	uint32_t blockSize = 256;
+	bool enableLFO = true;		///< S&H LFO draws from the global rand( ) state
+	bool paddedPlacement = false;
+};
+
+/**
+\struct BenchResult
+\brief
+Aggregate throughput and the per-instance p99 block times of one run.
+*/
+struct BenchResult
+{
+	double wallSeconds = 0.0;
+	double realtimeInstances = 0.0;		///< audio seconds processed per wall second
+	double medianP99_usec = 0.0;		///< median across instances of per-instance p99
+	double worstP99_usec = 0.0;			///< worst per-instance p99
+	uint32_t adjacentCacheLinePairs = 0;///< instances whose memory shares a cache line with another thread's instance
+};
+
+/**
+\class BenchInstance
+\brief
+One PluginCore plus the host-side buffers and info structures it is driven with.
+Placement is either packed (plain new, instances are heap neighbours) or padded
+(each instance on its own page) so false sharing can be measured.
+*/
+class BenchInstance
+{
+public:
+	BenchInstance(const BenchConfig& config)
+	{
+		if (config.paddedPlacement)
+		{
+			paddedStorage.reset(new unsigned char[sizeof(PluginCore) + 2 * kPaddedPlacement]);
+			void* ptr = paddedStorage.get();
+			size_t space = sizeof(PluginCore) + 2 * kPaddedPlacement;
+			core = new (std::align(kPaddedPlacement, sizeof(PluginCore), ptr, space)) PluginCore;
+		}
+		else
+			core = new PluginCore;
+
+		// --- parameters: splitter and ModFilter both active, doubled filter on
+		core->setPIParamValue(controlID::enableSplit, 1.0);
+		core->setPIParamValue(controlID::enableModFilter, 1.0);
+		core->setPIParamValue(controlID::enableDouble, 1.0);
+		core->setPIParamValue(controlID::enableLFO, config.enableLFO ? 1.0 : 0.0);
+		core->setPIParamValue(controlID::lfoRate, 20.0);
+		core->setPIParamValue(controlID::lfoDepth, 50.0);
+		core->setPIParamValue(controlID::lpfSaturation, 2.0);
+
+		ResetInfo resetInfo(kBenchSampleRate, 24);
+		core->reset(resetInfo);
+
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			input[i].resize(config.blockSize);
+			output[i].resize(config.blockSize);
+			inputPtrs[i] = &input[i][0];
+			outputPtrs[i] = &output[i][0];
+
+			// --- different noise per instance so branches are not trivially predicted
+			for (uint32_t n = 0; n < config.blockSize; n++)
+				input[i][n] = (float)(((n * 2654435761u + (uintptr_t)this + i) % 2000) / 1000.0 - 1.0) * 0.5f;
+		}
+
+		processInfo.inputs = &inputPtrs[0];
+		processInfo.outputs = &outputPtrs[0];
+		processInfo.numAudioInChannels = 2;
+		processInfo.numAudioOutChannels = 2;
+		processInfo.numFramesToProcess = config.blockSize;
+		processInfo.channelIOConfig = { kCFStereo, kCFStereo };
+		processInfo.hostInfo = &hostInfo;
+		processInfo.midiEventQueue = &midiQueue;
+
+		blockTimes_usec.reserve(config.blocks);
+	}
+
+	~BenchInstance()
+	{
+		if (paddedStorage)
+			core->~PluginCore();
+		else
+			delete core;
+	}
+
+	/** process one block the way the host shell does, timing the call */
+	inline void processBlock()
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		core->processAudioBuffers(processInfo);
+		std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+		blockTimes_usec.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+	}
+
+	/** p99 of the recorded block times */
+	double getP99_usec()
+	{
+		if (blockTimes_usec.empty())
+			return 0.0;
+
+		std::vector<double> sorted = blockTimes_usec;
+		size_t index = (size_t)(0.99 * (sorted.size() - 1));
+		std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+		return sorted[index];
+	}
+
+	/** address range of the instance, for the cache line adjacency check */
+	uintptr_t getFirstByte() { return (uintptr_t)core; }
+	uintptr_t getLastByte() { return (uintptr_t)core + sizeof(PluginCore) - 1; }
+
+protected:
+	PluginCore* core = nullptr;
+	std::unique_ptr<unsigned char[]> paddedStorage;
+	std::vector<float> input[2];
+	std::vector<float> output[2];
+	float* inputPtrs[2] = { nullptr };
+	float* outputPtrs[2] = { nullptr };
+	ProcessBufferInfo processInfo;
+	HostInfo hostInfo;
+	NullMidiEventQueue midiQueue;
+	std::vector<double> blockTimes_usec;
+};
+
+/**
+\brief run one configuration: instance i is owned by thread (i % threads), all threads
+start together and process their instances block by block, interleaved
+*/
+BenchResult runBenchmark(const BenchConfig& config)
+{
+	// --- create all instances up front (and on this thread) like a host loading a session
+	std::vector<std::unique_ptr<BenchInstance>> instances;
+	for (uint32_t i = 0; i < config.instances; i++)
+		instances.emplace_back(new BenchInstance(config));
+
+	std::atomic<uint32_t> readyCount(0);
+	std::atomic<bool> go(false);
+	std::vector<std::thread> workers;
+
+	for (uint32_t t = 0; t < config.threads; t++)
+	{
+		workers.emplace_back([&, t]()
+		{
+			readyCount++;
+			while (!go.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			for (uint32_t block = 0; block < config.blocks; block++)
+			{
+				for (uint32_t i = t; i < config.instances; i += config.threads)
+					instances[i]->processBlock();
+			}
+		});
+	}
+
+	while (readyCount.load() < config.threads)
+		std::this_thread::yield();
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	go.store(true, std::memory_order_release);
+	for (std::thread& worker : workers)
+		worker.join();
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+	BenchResult result;
+	result.wallSeconds = std::chrono::duration<double>(end - start).count();
+
+	double audioSeconds = (double)config.instances * config.blocks * config.blockSize / kBenchSampleRate;
+	result.realtimeInstances = audioSeconds / result.wallSeconds;
+
+	std::vector<double> p99s;
+	for (std::unique_ptr<BenchInstance>& instance : instances)
+		p99s.push_back(instance->getP99_usec());
+	std::sort(p99s.begin(), p99s.end());
+	result.medianP99_usec = p99s[p99s.size() / 2];
+	result.worstP99_usec = p99s.back();
+
+	// --- count instance pairs owned by different threads whose memory touches the same cache line
+	for (uint32_t i = 0; i < config.instances; i++)
+	{
+		for (uint32_t j = 0; j < config.instances; j++)
+		{
+			if (i == j || (i % config.threads) == (j % config.threads))
+				continue;
+
+			if (instances[i]->getLastByte() / kCacheLineSize == instances[j]->getFirstByte() / kCacheLineSize)
+				result.adjacentCacheLinePairs++;
+		}
+	}
+
+	return result;
+}
+
+/** --- RNG cost per call with the given number of threads hammering it: the global rand( ), or one generator per thread
+    (the same work with nothing shared, so the difference between the two is the cost of sharing rand( )'s state) */
+double measureRandNanoseconds(uint32_t threads, uint32_t callsPerThread, bool perThreadGenerator)
+{
+	std::atomic<bool> go(false);
+	std::atomic<uint32_t> sink(0);
+	std::vector<std::thread> workers;
+
+	for (uint32_t t = 0; t < threads; t++)
+	{
+		workers.emplace_back([&, t]()
+		{
+			std::minstd_rand generator(t + 1);
+			while (!go.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			uint32_t local = 0;
+			if (perThreadGenerator)
+			{
+				for (uint32_t n = 0; n < callsPerThread; n++)
+					local += (uint32_t)generator();
+			}
+			else
+			{
+				for (uint32_t n = 0; n < callsPerThread; n++)
+					local += (uint32_t)rand();
+			}
+			sink += local;
+		});
+	}
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	go.store(true, std::memory_order_release);
+	for (std::thread& worker : workers)
+		worker.join();
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+
+	// --- wall time per call as seen by one thread
+	return std::chrono::duration<double, std::nano>(end - start).count() / callsPerThread;
+}
+
+void printResult(const char* label, const BenchConfig& config, const BenchResult& result)
+{
+	double deadline_usec = 1.0e6 * config.blockSize / kBenchSampleRate;
+	printf("%-22s %4u inst %3u thr  %9.1f x realtime  p99 median %8.1f us  worst %8.1f us (%5.1f%% of %.0f us deadline)\n",
+		label, config.instances, config.threads, result.realtimeInstances,
+		result.medianP99_usec, result.worstP99_usec, 100.0 * result.worstP99_usec / deadline_usec, deadline_usec);
+}
+
+int main(int argc, char* argv[])
+{
+	BenchConfig config;
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	double seconds = 2.0;
+
+	if (argc > 1) config.instances = (uint32_t)std::max(1, atoi(argv[1]));
+	if (argc > 2) maxThreads = (uint32_t)std::max(1, atoi(argv[2]));
+	if (argc > 3) seconds = std::max(0.1, atof(argv[3]));
+	if (argc > 4) config.blockSize = (uint32_t)std::max(1, atoi(argv[4]));
+
+	config.blocks = (uint32_t)(seconds * kBenchSampleRate / config.blockSize);
+	if (config.blocks == 0)
+		config.blocks = 1;
+
+	printf("Quadra instance scaling: %u instances, up to %u threads, %.1f s of audio per instance, %u-frame blocks @ %.0f Hz\n",
+		config.instances, maxThreads, seconds, config.blockSize, kBenchSampleRate);
+	printf("sizeof(PluginCore) = %u bytes (%u cache lines)\n\n",
+		(uint32_t)sizeof(PluginCore), (uint32_t)((sizeof(PluginCore) + kCacheLineSize - 1) / kCacheLineSize));
+
+	// --- 1) thread scaling sweep
+	printf("--- scaling\n");
+	double singleThread = 0.0;
+	BenchResult widest;
+	std::vector<uint32_t> threadCounts;
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+		threadCounts.push_back(threads);
+	threadCounts.push_back(maxThreads);
+
+	for (uint32_t threads : threadCounts)
+	{
+		config.threads = std::min(threads, config.instances);
+		BenchResult result = runBenchmark(config);
+		if (threads == 1)
+			singleThread = result.realtimeInstances;
+
+		printResult("baseline", config, result);
+		printf("%-22s efficiency %.0f%%\n", "", 100.0 * result.realtimeInstances / (singleThread * config.threads));
+		widest = result;
+	}
+
+	// --- 2) shared-state diagnostics at the widest thread count
+	printf("\n--- shared state diagnostics (%u threads)\n", config.threads);
+
+	// --- global rand( ): the S&H LFO draws from it, SuperLFO::reset( ) reseeds it; turning the LFO off also removes
+	//     the LFO's own work, so that run only shows what the LFO costs in total, and contention is judged from rand( )
+	//     against a per-thread generator at the same thread count
+	BenchConfig noLFO = config;
+	noLFO.enableLFO = false;
+	BenchResult noLFOResult = runBenchmark(noLFO);
+	printResult("LFO off", noLFO, noLFOResult);
+	printf("LFO off / LFO on: %.2fx realtime instances (whole LFO cost, not only rand())\n",
+		noLFOResult.realtimeInstances / widest.realtimeInstances);
+
+	double randShared = measureRandNanoseconds(config.threads, 1000000, false);
+	double generatorPerThread = measureRandNanoseconds(config.threads, 1000000, true);
+	double randSlowdown = randShared / generatorPerThread;
+	printf("%u threads: rand() %.1f ns/call, per-thread generator %.1f ns/call (%.2fx) -> %s\n", config.threads,
+		randShared, generatorPerThread, randSlowdown, randSlowdown > 2.0 ? "FLAG (rand() contention)" : "within threshold");
+
+	// --- false sharing: packed (heap neighbours) vs padded (one page each)
+	BenchConfig padded = config;
+	padded.paddedPlacement = true;
+	BenchResult paddedResult = runBenchmark(padded);
+	printResult("padded placement", padded, paddedResult);
+	double paddedSpeedup = paddedResult.realtimeInstances / widest.realtimeInstances;
+	printf("packed placement: %u cross-thread instance pairs share a cache line\n", widest.adjacentCacheLinePairs);
+	// --- a difference with no shared cache lines is placement noise (page/TLB, allocator), not false sharing
+	const char* paddedVerdict = "within threshold";
+	if (paddedSpeedup > 1.0 + kFlagThreshold)
+		paddedVerdict = widest.adjacentCacheLinePairs > 0 ? "FLAG (false sharing)" : "above threshold, but no shared cache lines: not false sharing";
+	printf("padded / packed: %.2fx realtime instances -> %s\n", paddedSpeedup, paddedVerdict);
+
+	return 0;
+}
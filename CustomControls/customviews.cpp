@@ -13,6 +13,15 @@
 // -----------------------------------------------------------------------------
 #include "customviews.h"
 
+#ifdef HAVE_FFTW
+// --- for the SpectrumView worker's thread priority
+#if MAC
+#include <pthread.h>
+#elif WINDOWS
+#include <windows.h>
+#endif
+#endif
+
 namespace VSTGUI {
 
 /**
@@ -26,58 +35,79 @@ WaveView::WaveView(const VSTGUI::CRect& size, IControlListener* listener, int32_
 : ICustomView()
 , CControl(size, listener, tag)
 {
-    // --- create circular buffer that is same size as the window is wide
-	circularBuffer = new double[(int)size.getWidth()];
+    // --- create the peak pyramid; each level is as long as the window is wide
+	circularBufferLength = (int)size.getWidth();
+	peakPyramid = new WavePeak[WAVEVIEW_PYRAMID_LEVELS*circularBufferLength];
 
     // --- init
-	writeIndex = 0;
-	readIndex = 0;
-	circularBufferLength = (int)size.getWidth();
-    memset(circularBuffer, 0, circularBufferLength*sizeof(double));
+	clearBuffer();
 	paintXAxis = true;
 	currentRect = size;
 
     // --- ICustomView
-    // --- create our incoming data-queue
-    dataQueue = new moodycamel::ReaderWriterQueue<double, DATA_QUEUE_LEN>;
+    // --- create our incoming bin ring
+    peakRing.create(DATA_QUEUE_LEN);
 }
 
 WaveView::~WaveView()
 {
-    if(circularBuffer)
-        delete [] circularBuffer;
-
-    if(dataQueue)
-        delete dataQueue;
+    if(peakPyramid)
+        delete [] peakPyramid;
 }
 
 void WaveView::pushDataValue(double data)
 {
-    if(!dataQueue) return;
+    float sample = (float)data;
+    pushDataBlock(&sample, 1);
+}
+
+void WaveView::pushDataBlock(const float* data, uint32_t count)
+{
+    // --- reduce the block to min/max bins; a partial bin waits for the next block
+    WavePeak bins[DATA_READ_CHUNK_LEN];
+    uint32_t numBins = 0;
+    for(uint32_t i = 0; i < count; i++)
+    {
+        if(binCount == 0)
+            binPeak = WavePeak(data[i], data[i]);
+        else
+            binPeak.merge(WavePeak(data[i], data[i]));
 
-    // --- add data point, make room if needed
-    dataQueue->enqueue(data);
+        if(++binCount < WAVEVIEW_PEAK_BIN_LEN)
+            continue;
+
+        bins[numBins++] = binPeak;
+        binCount = 0;
+        if(numBins == DATA_READ_CHUNK_LEN)
+        {
+            peakRing.write(bins, numBins);
+            numBins = 0;
+        }
+    }
+
+    // --- one copy per block; whatever does not fit is dropped
+    if(numBins > 0)
+        peakRing.write(bins, numBins);
 }
 
 void WaveView::updateView()
 {
-    // --- get the max value that was added to the queue during the last
-    //     GUI timer ping interval
-    double audioSample = 0.0;
-    double max = 0.0;
-    bool success = dataQueue->try_dequeue(audioSample);
-    if(success)
+    // --- merge the bins that were added to the ring during the last
+    //     GUI timer ping interval into one column, a chunk at a time
+    WavePeak bins[DATA_READ_CHUNK_LEN];
+    uint32_t numBins = peakRing.read(bins, DATA_READ_CHUNK_LEN);
+    if(numBins > 0)
     {
-        max = audioSample;
-        while(success)
+        WavePeak column = bins[0];
+        while(numBins > 0)
         {
-            success = dataQueue->try_dequeue(audioSample);
-            if(success && audioSample > max)
-                max = audioSample;
+            for(uint32_t i = 0; i < numBins; i++)
+                column.merge(bins[i]);
+            numBins = peakRing.read(bins, DATA_READ_CHUNK_LEN);
         }
 
-        // --- add to circular buffer
-        addWaveDataPoint(fabs(max));
+        // --- add to the pyramid
+        addWavePeak(column);
     }
 
     // --- this will set the dirty flag to repaint the view
@@ -86,19 +116,57 @@ void WaveView::updateView()
 
 void WaveView::addWaveDataPoint(float fSample)
 {
-	if(!circularBuffer) return;
-	circularBuffer[writeIndex] = fSample;
-	writeIndex++;
-	if(writeIndex > circularBufferLength - 1)
-		writeIndex = 0;
+	addWavePeak(WavePeak(-fabs(fSample), fabs(fSample)));
+}
+
+void WaveView::addWavePeak(const WavePeak& peak)
+{
+	if(!peakPyramid) return;
+
+	// --- write into level 0, then carry merged pairs up the pyramid
+	WavePeak column = peak;
+	for(int level = 0; level < WAVEVIEW_PYRAMID_LEVELS; level++)
+	{
+		peakPyramid[level*circularBufferLength + writeIndex[level]] = column;
+		writeIndex[level]++;
+		if(writeIndex[level] > circularBufferLength - 1)
+			writeIndex[level] = 0;
+
+		if(level == WAVEVIEW_PYRAMID_LEVELS - 1)
+			break;
+
+		// --- the level above gets one column per two of these
+		if(pendingCount[level + 1] == 0)
+			pendingPeak[level + 1] = column;
+		else
+			pendingPeak[level + 1].merge(column);
+
+		if(++pendingCount[level + 1] < 2)
+			break;
+
+		column = pendingPeak[level + 1];
+		pendingCount[level + 1] = 0;
+	}
 }
 
 void WaveView::clearBuffer()
 {
-	if(!circularBuffer) return;
-	memset(circularBuffer, 0, circularBufferLength*sizeof(float));
-	writeIndex = 0;
-	readIndex = 0;
+	if(!peakPyramid) return;
+	for(int i = 0; i < WAVEVIEW_PYRAMID_LEVELS*circularBufferLength; i++)
+		peakPyramid[i] = WavePeak();
+	for(int level = 0; level < WAVEVIEW_PYRAMID_LEVELS; level++)
+	{
+		writeIndex[level] = 0;
+		pendingCount[level] = 0;
+	}
+}
+
+void WaveView::setZoomLevel(int _zoomLevel)
+{
+	if(_zoomLevel < 0) _zoomLevel = 0;
+	if(_zoomLevel > WAVEVIEW_PYRAMID_LEVELS - 1) _zoomLevel = WAVEVIEW_PYRAMID_LEVELS - 1;
+	zoomLevel = _zoomLevel;
+	invalid();
 }
 
 void WaveView::draw(CDrawContext* pContext)
@@ -119,23 +187,32 @@ void WaveView::draw(CDrawContext* pContext)
     pContext->setFrameColor(CColor(32, 0, 255, 200));
     pContext->setLineWidth(plotLineWidth);
 
-    if(!circularBuffer) return;
+    if(!peakPyramid) return;
 
-    // --- step through buffer
-    int index = writeIndex - 1;
+    // --- step through the zoom level's buffer, one column per pixel
+    const WavePeak* columns = peakPyramid + zoomLevel*circularBufferLength;
+    int index = writeIndex[zoomLevel] - 1;
     if(index < 0)
         index = circularBufferLength - 1;
 
     for(int i=1; i<circularBufferLength; i++)
     {
-        double sample = circularBuffer[index--];
-
-        double normalized = sample*(double)size.getHeight();
-        if(normalized > size.getHeight() - 2)
-            normalized = (double)size.getHeight();
+        const WavePeak& peak = columns[index--];
+
+        // --- top and bottom of the column, clipped to the view
+        double top = peak.maxValue*(double)size.getHeight()/2.0;
+        double bottom = -peak.minValue*(double)size.getHeight()/2.0;
+        if(top > size.getHeight()/2.0 - 1)
+            top = size.getHeight()/2.0;
+        if(bottom > size.getHeight()/2.0 - 1)
+            bottom = size.getHeight()/2.0;
+        if(top < -size.getHeight()/2.0)
+            top = -size.getHeight()/2.0;
+        if(bottom < -size.getHeight()/2.0)
+            bottom = -size.getHeight()/2.0;
 
         // --- so there is an x-axis even if no data
-        if(normalized == 0) normalized = 0.1f;
+        if(top <= 0 && bottom <= 0) top = bottom = 0.05;
 
         if (paintXAxis)
         {
@@ -150,17 +227,11 @@ void WaveView::draw(CDrawContext* pContext)
 #endif
         }
 
-        // --- halves
-        normalized /= 2.f;
+        // --- one line from max to min
+        const CPoint p1(size.left + i, size.bottom - size.getHeight()/2.f - top);
+        const CPoint p2(size.left + i, size.bottom - size.getHeight()/2.f + bottom);
 
-        // --- find the three points of interest
-        const CPoint p1(size.left + i, size.bottom - size.getHeight()/2.f);
-        const CPoint p2(size.left + i, size.bottom - size.getHeight()/2.f - normalized);
-        const CPoint p3(size.left + i, size.bottom - size.getHeight()/2.f + normalized);
-
-        // --- move and draw lines
         pContext->drawLine(p1, p2);
-        pContext->drawLine(p1, p3);
 
         // --- wrap the index value if needed
         if(index < 0)
@@ -180,8 +251,8 @@ SpectrumView::SpectrumView(const VSTGUI::CRect& size, IControlListener* listener
 : CControl(size, listener, tag)
 {
     // --- ICustomView
-    // --- create our incoming data-queue
-    dataQueue = new moodycamel::ReaderWriterQueue<double,FFT_LEN>;
+    // --- create our incoming data ring
+    dataRing.create(FFT_LEN);
 
     // --- double buffers for mag FFTs
     fftMagBuffersReady = new moodycamel::ReaderWriterQueue<double*,2>;
@@ -194,34 +265,46 @@ SpectrumView::SpectrumView(const VSTGUI::CRect& size, IControlListener* listener
     // --- buffer being drawn, only ever used by draw code
     currentFFTMagBuffer = nullptr;
 
-    // --- FFTW inits
-    data        = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * FFT_LEN);
-    fft_result  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * FFT_LEN);
-    ifft_result = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * FFT_LEN);
+    // --- FFTW inits: real input, so only FFT_LEN/2 + 1 outputs and no backward plan
+    data        = (double*) fftw_malloc(sizeof(double) * FFT_LEN);
+    fft_result  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * (FFT_LEN/2 + 1));
 
-    plan_forward  = fftw_plan_dft_1d(FFT_LEN, data, fft_result, FFTW_FORWARD, FFTW_ESTIMATE);
-    plan_backward = fftw_plan_dft_1d(FFT_LEN, fft_result, ifft_result, FFTW_BACKWARD, FFTW_ESTIMATE);
+    // --- shared r2c plan; made once per module by the registry, run on our arrays
+    plan_forward  = FFTWPlanRegistry::getInstance().getPlan(FFT_LEN, fftPlanType::kRealForward);
 
-    // --- window
-    setWindow(spectrumViewWindowType::kBlackmanHarrisWindow);
+    // --- window and log-frequency binning
+    window = spectrumViewWindowType::kBlackmanHarrisWindow;
+    requestedWindow.store(window);
+    buildWindow();
+    buildLogBins();
+
+    // --- start the worker last; everything it touches exists now
+    analysisRunning.store(true);
+    analysisThread = std::thread(&SpectrumView::analysisLoop, this);
 }
 
 SpectrumView::~SpectrumView()
 {
-    fftw_destroy_plan( plan_forward );
-    fftw_destroy_plan( plan_backward );
+    // --- stop the worker first
+    analysisRunning.store(false);
+    if(analysisThread.joinable())
+        analysisThread.join();
 
     fftw_free( data );
     fftw_free( fft_result );
-    fftw_free( ifft_result );
 
-    if(dataQueue)
-        delete dataQueue;
+    delete fftMagBuffersReady;
+    delete fftMagBuffersEmpty;
 }
 
 void SpectrumView::setWindow(spectrumViewWindowType _window)
 {
-    window = _window;
+    // --- picked up by the worker before its next FFT
+    requestedWindow.store(_window);
+}
+
+void SpectrumView::buildWindow()
+{
     memset(&fftWindow[0], 0, FFT_LEN*sizeof(double));
 
     // --- rectangular has fftWindow[0] = 0, fftWindow[FFT_LEN-1] = 0, all other points = 1.0
@@ -247,13 +330,46 @@ void SpectrumView::setWindow(spectrumViewWindowType _window)
     }
 }
 
+void SpectrumView::buildLogBins()
+{
+    // --- display point k spans FFT bins [N^(k/len), N^((k+1)/len)), N = FFT_LEN/2, so each
+    //     point covers the same fraction of an octave; low points that fall between two bins
+    //     are interpolated at the geometric center of their span instead
+    const double numBins = FFT_LEN/2;
+    for(int k = 0; k < SPECTRUM_DISPLAY_LEN; k++)
+    {
+        double lowEdge = pow(numBins, (double)k/SPECTRUM_DISPLAY_LEN);
+        double highEdge = pow(numBins, (double)(k + 1)/SPECTRUM_DISPLAY_LEN);
+        logBinStart[k] = (int)ceil(lowEdge);
+        logBinEnd[k] = (int)ceil(highEdge);
+        if(logBinEnd[k] > FFT_LEN/2 + 1)
+            logBinEnd[k] = FFT_LEN/2 + 1;
+        logBinCenter[k] = sqrt(lowEdge*highEdge);
+    }
+}
+
+void SpectrumView::analysisLoop()
+{
+    // --- keep out of the way of the audio and GUI threads
+#if MAC
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif WINDOWS
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#endif
+
+    while(analysisRunning.load())
+    {
+        analyzeSpectrum();
+        std::this_thread::sleep_for(std::chrono::milliseconds(SPECTRUM_ANALYSIS_INTERVAL_MSEC));
+    }
+}
+
 bool SpectrumView::addFFTInputData(double inputSample)
 {
     if(fftInputCounter >= FFT_LEN)
         return false;
 
-    data[fftInputCounter][0] = inputSample*fftWindow[fftInputCounter]; // stick your audio samples in here
-    data[fftInputCounter][1] = 0.0; // use this if your data is complex valued
+    data[fftInputCounter] = inputSample*fftWindow[fftInputCounter]; // stick your audio samples in here
 
     fftInputCounter++;
     if(fftInputCounter == FFT_LEN)
@@ -265,70 +381,105 @@ bool SpectrumView::addFFTInputData(double inputSample)
 
 void SpectrumView::pushDataValue(double data)
 {
-    if(!dataQueue) return;
+    // --- add data point; dropped if the ring is full
+    float sample = (float)data;
+    dataRing.write(&sample, 1);
+}
 
-    // --- add data point, make room if needed
-    dataQueue->enqueue(data);
+void SpectrumView::pushDataBlock(const float* data, uint32_t count)
+{
+    // --- one copy per block; whatever does not fit is dropped
+    dataRing.write(data, count);
 }
 
-void SpectrumView::updateView()
+bool SpectrumView::analyzeSpectrum()
 {
-    // --- grab samples from incoming queue and add to FFT input
-    double audioSample = 0.0;
-    bool success = dataQueue->try_dequeue(audioSample);
-    if(!success) return;
+    // --- a new window applies from the start of the next frame
+    spectrumViewWindowType newWindow = requestedWindow.load();
+    if(newWindow != window)
+    {
+        window = newWindow;
+        buildWindow();
+        fftInputCounter = 0;
+    }
+
+    // --- grab samples from incoming ring, a chunk at a time, and add to FFT input
+    float audioSamples[DATA_READ_CHUNK_LEN];
+    uint32_t numSamples = dataRing.read(audioSamples, DATA_READ_CHUNK_LEN);
+    if(numSamples == 0) return false;
     bool fftReady = false;
-    while(success)
+    while(numSamples > 0)
     {
         // --- keep adding values into the array; it will stop when full
         //     and return TRUE if the FFT buffer is full and we are ready
         //     to do a FFT
-        if(addFFTInputData(audioSample))
-            fftReady = true; // sticky flag
+        for(uint32_t i = 0; i < numSamples; i++)
+        {
+            if(addFFTInputData(audioSamples[i]))
+                fftReady = true; // sticky flag
+        }
 
         // --- for this wave view, we can only show the FFT of the last
-        //     512 points anyway, so we just keep popping them from the queue
-        success = dataQueue->try_dequeue(audioSample);
+        //     512 points anyway, so we just keep draining the ring
+        numSamples = dataRing.read(audioSamples, DATA_READ_CHUNK_LEN);
     }
 
-    if(fftReady)
-    {
-        // do the FFT
-        fftw_execute(plan_forward);
+    if(!fftReady)
+        return false;
 
-        double* bufferToFill = nullptr;
-        fftMagBuffersEmpty->try_dequeue(bufferToFill);
+    // --- the frame is consumed either way
+    fftInputCounter = 0;
+    if(!plan_forward)
+        return false;
 
-        if(!bufferToFill)
-        {
-            fftReady = false;
-            fftInputCounter = 0;
-            return;
-        }
+    double* bufferToFill = nullptr;
+    fftMagBuffersEmpty->try_dequeue(bufferToFill);
+    if(!bufferToFill)
+        return false;
+
+    // do the FFT
+    fftw_execute_dft_r2c(plan_forward, data, fft_result);
 
-        int maxIndex = 0;
-        for(int i=0; i<FFT_LEN; i++)
+    // --- power spectrum: a straight pass over the interleaved re/im pairs that the
+    //     compiler can vectorize; the square root is left for the display points only
+    const double* bins = &fft_result[0][0];
+    for(int i=0; i<FFT_LEN/2 + 1; i++)
+        powerSpectrum[i] = bins[2*i]*bins[2*i] + bins[2*i + 1]*bins[2*i + 1];
+
+    // --- log-frequency points: peak power over each span, interpolated where a span has no bin
+    for(int k=0; k<SPECTRUM_DISPLAY_LEN; k++)
+    {
+        double power = 0.0;
+        if(logBinEnd[k] > logBinStart[k])
         {
-            bufferToFill[i] = (getMagnitude(fft_result[i][0], fft_result[i][1]));
+            for(int i = logBinStart[k]; i < logBinEnd[k]; i++)
+            {
+                if(powerSpectrum[i] > power)
+                    power = powerSpectrum[i];
+            }
         }
+        else
+            power = interpArrayValue(powerSpectrum, FFT_LEN/2 + 1, logBinCenter[k]);
 
-        // --- normalize the FFT buffer for max = 1.0 (note this is NOT dB!!)
-        normalizeBufferGetFMax(bufferToFill, 512, &maxIndex);
-
-        // 1) homework = do plot in dB
-        // 2) homework = add other windows
-        // 3) homework = plot frequency on log x-axis (HARD!)
+        // --- temporal smoothing of the magnitude
+        smoothedMagnitude[k] = SPECTRUM_SMOOTHING*smoothedMagnitude[k] + (1.0 - SPECTRUM_SMOOTHING)*sqrt(power);
+        bufferToFill[k] = smoothedMagnitude[k];
+    }
 
-        // --- add the new FFT buffer to the queue
-        fftMagBuffersReady->enqueue(bufferToFill);
+    // --- normalize the FFT buffer for max = 1.0 (note this is NOT dB!!)
+    int maxIndex = 0;
+    normalizeBufferGetFMax(bufferToFill, SPECTRUM_DISPLAY_LEN, &maxIndex);
 
-        // --- set flags (can reduce number of flags?)
-        fftReady = false;
-        fftInputCounter = 0;
-    }
+    // --- add the new FFT buffer to the queue
+    fftMagBuffersReady->enqueue(bufferToFill);
+    return true;
+}
 
-    // --- this will set the dirty flag to repaint the view
-    invalid();
+void SpectrumView::updateView()
+{
+    // --- the worker does the analysis; only repaint when it has published something
+    if(fftMagBuffersReady->peek())
+        invalid();
 }
 
 void SpectrumView::draw(CDrawContext* pContext)
@@ -363,8 +514,8 @@ void SpectrumView::draw(CDrawContext* pContext)
     if(!currentFFTMagBuffer)
         return;
 
-    // --- plot the FFT data
-    double step = 128.0/size.getWidth();
+    // --- plot the FFT data; the points are already log-frequency spaced
+    double step = (double)SPECTRUM_DISPLAY_LEN/size.getWidth();
     double magIndex = 0.0;
 
     // --- plot first point
@@ -384,7 +535,7 @@ void SpectrumView::draw(CDrawContext* pContext)
         magIndex += step;
 
         // --- interpolate to find magnitude at this step
-        yn = interpArrayValue(currentFFTMagBuffer, 128, magIndex);
+        yn = interpArrayValue(currentFFTMagBuffer, SPECTRUM_DISPLAY_LEN, magIndex);
 
         // --- calculate top (y) value of point
         ypt = size.bottom - size.getHeight()*yn;
@@ -419,6 +570,130 @@ void SpectrumView::draw(CDrawContext* pContext)
 
 #endif
 
+/**
+\brief FilterCurveView constructor
+
+\param size - the control rectangle
+\param listener - the control's listener (usuall PluginGUI object)
+\param tag - the control ID value
+*/
+FilterCurveView::FilterCurveView(const VSTGUI::CRect& size, IControlListener* listener, int32_t tag)
+: ICustomView()
+, CControl(size, listener, tag)
+{
+	// --- the frequency grid is fixed by the view width; only the sample rate rebuilds the tables
+	int numPoints = (int)size.getWidth() / FILTER_CURVE_PIXELS_PER_POINT + 1;
+	evaluator.setFrequencyRange(numPoints > 2 ? numPoints : 2, FILTER_CURVE_MIN_FREQUENCY, FILTER_CURVE_MAX_FREQUENCY);
+}
+
+/**
+\brief copy a FilterCurveSnapshot into the mailbox; called on the audio thread, never blocks
+
+\param data - a FilterCurveSnapshot*
+*/
+void FilterCurveView::sendMessage(void* data)
+{
+	if (data)
+		snapshotMailbox.write(*static_cast<FilterCurveSnapshot*>(data));
+}
+
+/**
+\brief evaluate the newest snapshot and repaint; called from the GUI timer
+*/
+void FilterCurveView::updateView()
+{
+	if (!snapshotMailbox.read(snapshot))
+		return;
+
+	curveReady = evaluator.evaluate(snapshot);
+	invalid();
+}
+
+/**
+\brief map a level to the view
+
+\param dB - level in dB
+\param size - the view rectangle
+*/
+CCoord FilterCurveView::dBToY(double dB, const CRect& size)
+{
+	double position = (FILTER_CURVE_TOP_DB - dB) / (FILTER_CURVE_TOP_DB - FILTER_CURVE_BOTTOM_DB);
+	if (position < 0.0)
+		position = 0.0;
+	if (position > 1.0)
+		position = 1.0;
+	return size.top + position*size.getHeight();
+}
+
+/**
+\brief draw one curve; the grid points are evenly spaced in log frequency, so evenly spaced in x
+
+\param pContext - the draw context
+\param curve_dB - evaluator.getNumPoints() levels in dB
+\param size - the view rectangle
+*/
+void FilterCurveView::drawCurve(CDrawContext* pContext, const double* curve_dB, const CRect& size)
+{
+	uint32_t numPoints = evaluator.getNumPoints();
+	double step = size.getWidth() / (numPoints - 1);
+
+	CPoint lastPoint(size.left, dBToY(curve_dB[0], size));
+	for (uint32_t k = 1; k < numPoints; k++)
+	{
+		CPoint point(size.left + k*step, dBToY(curve_dB[k], size));
+		pContext->drawLine(lastPoint, point);
+		lastPoint = point;
+	}
+}
+
+/**
+\brief draw the background, the 0dB line, the band and ModFilter curves and the total response
+
+\param pContext - the draw context
+*/
+void FilterCurveView::draw(CDrawContext* pContext)
+{
+	// --- setup the backround rectangle
+	pContext->setLineWidth(1);
+	pContext->setFillColor(CColor(200, 200, 200, 255)); // light grey
+	pContext->setFrameColor(CColor(0, 0, 0, 255)); // black
+
+	CRect size = getViewSize();
+	pContext->drawRect(size, kDrawFilledAndStroked);
+
+	// --- 0dB reference
+	pContext->setFrameColor(CColor(128, 128, 128, 255));
+	CCoord zero_dB = dBToY(0.0, size);
+	pContext->drawLine(CPoint(size.left, zero_dB), CPoint(size.right, zero_dB));
+
+	if (!curveReady)
+		return;
+
+	// --- band curves, semi-transparent
+	if (snapshot.splitterEnabled)
+	{
+		const CColor bandColors[FILTER_CURVE_NUM_BANDS] = { CColor(255, 64, 0, 160), CColor(0, 160, 0, 160),
+															CColor(0, 96, 255, 160), CColor(160, 0, 200, 160) };
+		for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
+		{
+			pContext->setFrameColor(bandColors[b]);
+			drawCurve(pContext, evaluator.getBandCurve(b), size);
+		}
+	}
+
+	// --- ModFilter curve
+	if (snapshot.modFilterEnabled)
+	{
+		pContext->setFrameColor(CColor(200, 160, 0, 200));
+		drawCurve(pContext, evaluator.getModFilterCurve(), size);
+	}
+
+	// --- total response on top
+	pContext->setLineWidth(2);
+	pContext->setFrameColor(CColor(32, 0, 255, 255));
+	drawCurve(pContext, evaluator.getTotalCurve(), size);
+}
+
 /**
 \brief CustomKnobView constructor
 
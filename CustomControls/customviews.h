@@ -17,12 +17,48 @@
 #include "vstgui/vstgui_uidescription.h" // for IController
 
 #include "../PluginKernel/pluginstructures.h"
+#include "../PluginObjects/filtercurve.h"
 
 namespace VSTGUI {
 
 // --- with an update cycle of ~50mSec, we need at least 2205 samples; this should be more than enough
 const int DATA_QUEUE_LEN = 4096;
 
+// --- updateView( ) drains the sample ring in chunks of this many samples
+const int DATA_READ_CHUNK_LEN = 256;
+
+// --- WaveView: the audio side reduces this many samples to one min/max bin before queueing it
+const int WAVEVIEW_PEAK_BIN_LEN = 32;
+
+// --- WaveView: zoom levels kept in the peak pyramid; level n shows 2^n timer ticks per pixel column
+const int WAVEVIEW_PYRAMID_LEVELS = 4;
+
+/**
+\struct WavePeak
+\ingroup Custom-Views
+\brief
+The minimum and maximum of a run of samples; one per WaveView bin and per drawn pixel column.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct WavePeak
+{
+	WavePeak() {}
+	WavePeak(float _minValue, float _maxValue) : minValue(_minValue), maxValue(_maxValue) {}
+
+	/** widen this peak to cover another */
+	inline void merge(const WavePeak& peak)
+	{
+		if (peak.minValue < minValue) minValue = peak.minValue;
+		if (peak.maxValue > maxValue) maxValue = peak.maxValue;
+	}
+
+	float minValue = 0.f;	///< most negative sample
+	float maxValue = 0.f;	///< most positive sample
+};
+
 /**
 \class WaveView
 \ingroup Custom-Views
@@ -30,12 +66,15 @@ const int DATA_QUEUE_LEN = 4096;
 This object displays an audio histogram waveform view.\n
 
 WaveView:
-- uses a lock-free ring buffer for queueing up input data from the plugin
-- implements ICustomView::pushDataValue() and ICustomView::updateView()
-- the updateData() function finds the largest value that was pushed into
-the data queue and adds that to the waveform buffer (circular)
-- uses a circular buffer to make waveform appear to scroll
-- each new input point pushes oldest sample out of the buffer
+- the audio side reduces incoming samples to min/max bins of WAVEVIEW_PEAK_BIN_LEN samples and
+queues the bins on a wait-free SampleBlockRing, so the queue traffic is independent of the drawing
+- implements ICustomView::pushDataValue(), ICustomView::pushDataBlock() and ICustomView::updateView()
+- the updateView() function merges the bins that arrived during the last timer tick into one
+min/max column and adds that to a small peak pyramid: level 0 holds one column per tick, each
+higher level merges pairs from the level below, every level one view-width long (circular)
+- draw() walks only the current zoom level's columns, one line per pixel, so the cost scales with
+the view width, not the sample rate
+- each new column pushes the oldest one out of its level, making the waveform appear to scroll
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
@@ -54,15 +93,28 @@ public:
 	/** ICustomView method: push a new audio sample into the ring buffer */
 	virtual void pushDataValue(double data) override;
 
+	/** ICustomView method: push a block of audio samples into the ring buffer in one copy */
+	virtual void pushDataBlock(const float* data, uint32_t count) override;
+
 	/** add a new point to the circular buffer for painting
 	\param fSample the absolute value of the sample
 	*/
 	void addWaveDataPoint(float fSample);
 
+	/** add a new min/max column to the peak pyramid for painting
+	\param peak the column's range
+	*/
+	void addWavePeak(const WavePeak& peak);
+
 	/** reset the circular buffer for a new run
 	*/
 	void clearBuffer();
 
+	/** choose the pyramid level to draw
+	\param _zoomLevel 0 (one tick per column) to WAVEVIEW_PYRAMID_LEVELS - 1
+	*/
+	void setZoomLevel(int _zoomLevel);
+
 	/** toggles showng of x axis
 	\param _paintXAxis enable/disable functionality
 	*/
@@ -80,22 +132,31 @@ protected:
     // --- turn on/off zerodB line
     bool paintXAxis = true; ///< flag for painting X Axis
 
-    // --- circular buffer and index values
-    double* circularBuffer = nullptr;	///< circular buffer to store peak values
-    int writeIndex = 0;		///< circular buffer write location
-    int readIndex = 0;		///< circular buffer read location
-    int circularBufferLength = 0;///< circular buffer length
+    // --- peak pyramid: WAVEVIEW_PYRAMID_LEVELS circular buffers of circularBufferLength columns each
+    WavePeak* peakPyramid = nullptr;	///< level n starts at peakPyramid + n*circularBufferLength
+    int writeIndex[WAVEVIEW_PYRAMID_LEVELS] = { 0 };	///< per level circular buffer write location
+    WavePeak pendingPeak[WAVEVIEW_PYRAMID_LEVELS];		///< per level column being merged from the level below
+    int pendingCount[WAVEVIEW_PYRAMID_LEVELS] = { 0 };	///< columns merged into pendingPeak so far
+    int circularBufferLength = 0;///< circular buffer length (per level)
+    int zoomLevel = 0;		///< level draw() shows
 	CRect currentRect;		///< the rect to draw into
 
 private:
-    // --- lock-free queue for incoming data, sized to DATA_QUEUE_LEN in length
-    moodycamel::ReaderWriterQueue<double, DATA_QUEUE_LEN>* dataQueue = nullptr; ///< lock-free queue for incoming data, sized to DATA_QUEUE_LEN in length
+    // --- audio side bin being reduced; touched only by the pushing thread
+    WavePeak binPeak;		///< min/max of the current bin
+    int binCount = 0;		///< samples in the current bin
+
+    // --- wait-free ring for incoming min/max bins, sized to DATA_QUEUE_LEN in length
+    SampleBlockRing<WavePeak> peakRing; ///< wait-free ring for incoming bins; full blocks are dropped, never queued
 
 };
 
 #ifdef HAVE_FFTW
 // --- FFTW (REQUIRED)
 #include "fftw3.h"
+#include "fftwplanregistry.h"
+#include <thread>
+#include <chrono>
 
 /**
 \enum spectrumViewWindowType
@@ -115,6 +176,11 @@ enum class spectrumViewWindowType {kRectWindow, kHannWindow, kBlackmanHarrisWind
 // --- change this for higher accuracy; needs to be power of 2
 const int FFT_LEN = 512;
 
+// --- SpectrumView analysis: log-spaced display points, smoothing and worker period
+const int SPECTRUM_DISPLAY_LEN = 128;				///< log-frequency points handed to draw(); <= FFT_LEN
+const double SPECTRUM_SMOOTHING = 0.6;				///< one-pole temporal smoothing of the magnitudes; 0 = none
+const int SPECTRUM_ANALYSIS_INTERVAL_MSEC = 20;		///< worker wake-up period
+
 // --- SpectrumView
 /*
 */
@@ -125,16 +191,16 @@ const int FFT_LEN = 512;
 This object displays the FFT of the incoming data.\n
 
 SpectrumView:
-- uses a lock-free ring buffer for queueing up input data from the plugin
-- implements ICustomView::pushDataValue() and ICustomView::updateData()
-- uses a pair of lock-free ring buffers to implement a safe double-buffering system
-- during updates, the queue is dumped into the FFT array
-- when a new FFT is processed, its magnitude array is calculated in the first
-available buffer in the empty queue; it is then placed in the filled (ready) queue
-- the draw() function is on the same thread with the PluginKernel/PluginGUI paradigm\
-but just in case it ISN'T, the drawing uses the double buffer to safely get the
-next available magnitude array to display
-- the result is a super fast visually synchronized display
+- uses a wait-free SampleBlockRing for queueing up input data from the plugin
+- implements ICustomView::pushDataValue(), ICustomView::pushDataBlock() and ICustomView::updateData()
+- the analysis runs on a low-priority worker thread that wakes every SPECTRUM_ANALYSIS_INTERVAL_MSEC:
+it drains the ring into the FFT input, runs a real-input (r2c) FFT with a plan shared through
+FFTWPlanRegistry, reduces the power spectrum to SPECTRUM_DISPLAY_LEN log-spaced points, smooths them
+over time and normalizes them
+- uses a pair of lock-free ring buffers to implement a safe double-buffering system between the
+worker and draw(): the worker fills a buffer from the empty queue and places it in the filled (ready)
+queue; draw() swaps in the newest ready buffer and returns the old one
+- updateView() and draw() only repaint, so the GUI thread never does FFT work
 
 \author Will Pirkle http://www.willpirkle.com
 \remark This object is included in Designing Audio Effects Plugins in C++ 2nd Ed. by Will Pirkle
@@ -145,7 +211,7 @@ class SpectrumView : public CControl, public ICustomView
 {
 public:
     SpectrumView(const CRect& size, IControlListener* listener, int32_t tag);
-    ~SpectrumView();
+    ~SpectrumView();	///< stops the worker before anything it uses is freed
 
 	/** ICustomView method: this repaints the control */
 	virtual void updateView() override;
@@ -153,10 +219,13 @@ public:
 	/** ICustomView method: push a new audio sample into the ring buffer */
 	virtual void pushDataValue(double data) override;
 
+	/** ICustomView method: push a block of audio samples into the ring buffer in one copy */
+	virtual void pushDataBlock(const float* data, uint32_t count) override;
+
 	/** show FFT as filled (or unfilled) plot */
 	void showFilledFFT(bool _filledFFT) { filledFFT = _filledFFT; }
 
-	/** set the window
+	/** set the window; the worker applies it before its next FFT
 	\param _window the window type (seee windowType)
 	*/
 	void setWindow(spectrumViewWindowType _window);
@@ -168,29 +237,52 @@ public:
     CLASS_METHODS(SpectrumView, CControl)
 
 protected:
-    // --- for windowing; this doesn't need to be saved in current
-    //     implementation but you may need it for homework/upgrading the object
-	spectrumViewWindowType window = spectrumViewWindowType::kRectWindow; ///< window type
+    // --- for windowing; window is the worker's copy, requestedWindow is set from any thread
+	spectrumViewWindowType window = spectrumViewWindowType::kRectWindow; ///< window type in fftWindow
+	std::atomic<spectrumViewWindowType> requestedWindow{ spectrumViewWindowType::kRectWindow }; ///< window set by setWindow()
 
-    // --- setup FFTW
-    fftw_complex* data = nullptr;			///< fft input data
+    // --- setup FFTW; real input, FFT_LEN/2 + 1 complex outputs
+    double* data = nullptr;					///< fft input data
 	fftw_complex* fft_result = nullptr;		///< fft output data
-	fftw_complex* ifft_result = nullptr;	///< ifft output (not used)
-	fftw_plan plan_forward;					///< plan for FFT
-	fftw_plan plan_backward;				///< plan for IFFT (not used)
+	fftw_plan plan_forward = nullptr;		///< shared r2c plan (owned by FFTWPlanRegistry)
 
     // --- for FFT data input
     int fftInputCounter = 0;				///< input counter for FFT
 
+    // --- worker thread
+    std::thread analysisThread;						///< runs analysisLoop()
+    std::atomic<bool> analysisRunning{ false };		///< worker run flag
+
+    // --- log-frequency binning, built once at construction
+    int logBinStart[SPECTRUM_DISPLAY_LEN] = { 0 };		///< first FFT bin of each display point
+    int logBinEnd[SPECTRUM_DISPLAY_LEN] = { 0 };		///< one past the last FFT bin; == start when the point falls between bins
+    double logBinCenter[SPECTRUM_DISPLAY_LEN] = { 0.0 };	///< fractional FFT bin used when the point falls between bins
+    double powerSpectrum[FFT_LEN / 2 + 1] = { 0.0 };	///< |X|^2 of the last FFT
+    double smoothedMagnitude[SPECTRUM_DISPLAY_LEN] = { 0.0 };	///< temporally smoothed display magnitudes
+
+    /** fill fftWindow for the current window type */
+    void buildWindow();
+
+    /** precompute logBinStart/End/Center */
+    void buildLogBins();
+
+    /** worker: analyze, then sleep, until analysisRunning is cleared */
+    void analysisLoop();
+
+    /** worker: drain the ring and, when a full FFT frame is in, publish a new magnitude buffer
+    \return true if a buffer was published
+    */
+    bool analyzeSpectrum();
+
  	/** returns true if the input buffer is full and ready for a FFT operation \n
 	will keep track of indexing and reject samples when full
 	\param inputSample input point for FFT
 	*/
     bool addFFTInputData(double inputSample);
 
-    // --- a double buffer pair of magnitude arrays
-    double fftMagnitudeArray_A[FFT_LEN] = {0.0}; ///< 1/2 of double buffer (yes this is overkill but showing as demonstration!!)
-    double fftMagnitudeArray_B[FFT_LEN] = {0.0}; ///< 1/2 of double buffer (yes this is overkill but showing as demonstration!!)
+    // --- a double buffer pair of magnitude arrays, SPECTRUM_DISPLAY_LEN points each
+    double fftMagnitudeArray_A[SPECTRUM_DISPLAY_LEN] = {0.0}; ///< 1/2 of double buffer (yes this is overkill but showing as demonstration!!)
+    double fftMagnitudeArray_B[SPECTRUM_DISPLAY_LEN] = {0.0}; ///< 1/2 of double buffer (yes this is overkill but showing as demonstration!!)
 
     // --- buffer for the assigned window
     double fftWindow[FFT_LEN] = {1.0}; ///< window buffer
@@ -270,8 +362,8 @@ protected:
     bool filledFFT = true; ///< flag for filled FFT
 
 private:
-    // --- lock-free queue for incoming data, sized to FFT_LEN in length
-    moodycamel::ReaderWriterQueue<double,FFT_LEN>* dataQueue = nullptr; ///< lock free ring buffer
+    // --- wait-free ring for incoming data, sized to FFT_LEN in length
+    SampleBlockRing<float> dataRing; ///< wait-free ring; only one FFT's worth is ever used per update
 
     // --- a pair of lock-free queues to store empty and full magnitude buffers
     //     these are setup as double buffers but you can easily extend them
@@ -281,6 +373,62 @@ private:
 };
 #endif // defined FFTW
 
+// --- FilterCurveView: displayed frequency and level ranges, and grid density
+const double FILTER_CURVE_MIN_FREQUENCY = 20.0;		///< left edge, Hz
+const double FILTER_CURVE_MAX_FREQUENCY = 20000.0;	///< right edge, Hz
+const double FILTER_CURVE_TOP_DB = 18.0;			///< top edge
+const double FILTER_CURVE_BOTTOM_DB = -36.0;		///< bottom edge
+const int FILTER_CURVE_PIXELS_PER_POINT = 2;		///< one evaluated frequency per this many pixels of width
+
+/**
+\class FilterCurveView
+\ingroup Custom-Views
+\brief
+This object draws the analytic magnitude response of the band splitter and the ModFilter from biquad coefficient
+snapshots, instead of analyzing the audio.
+
+FilterCurveView:
+- the audio thread sends a FilterCurveSnapshot (via ICustomView::sendMessage()) only when the coefficients or
+gains changed; the view keeps just the newest one in a LatestValueMailbox, so nothing queues up
+- updateView() takes the newest snapshot, if any, evaluates it with a FilterCurveEvaluator on a log-frequency grid
+(one point per FILTER_CURVE_PIXELS_PER_POINT pixels) and repaints; no new snapshot, no work
+- draw() plots the four band curves, the ModFilter curve and the total response of the linear path
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class FilterCurveView : public CControl, public ICustomView
+{
+public:
+	FilterCurveView(const CRect& size, IControlListener* listener, int32_t tag);
+	~FilterCurveView() {}
+
+	/** ICustomView method: evaluate the newest snapshot, if one arrived, and repaint */
+	virtual void updateView() override;
+
+	/** ICustomView method: data is a FilterCurveSnapshot*, copied into the mailbox (audio thread) */
+	virtual void sendMessage(void* data) override;
+
+	/** override to draw, called if the view should draw itself*/
+	void draw(CDrawContext* pContext) override;
+
+	// --- for CControl pure abstract functions
+	CLASS_METHODS(FilterCurveView, CControl)
+
+protected:
+	LatestValueMailbox<FilterCurveSnapshot> snapshotMailbox;	///< audio thread -> GUI, newest only
+	FilterCurveSnapshot snapshot;			///< GUI copy of the newest snapshot
+	FilterCurveEvaluator evaluator;			///< evaluates the snapshot on the frequency grid
+	bool curveReady = false;				///< true once a snapshot has been evaluated
+
+	/** \return the y coordinate of a level in dB, clamped to the view */
+	CCoord dBToY(double dB, const CRect& size);
+
+	/** draw one evaluated curve as a polyline across the view */
+	void drawCurve(CDrawContext* pContext, const double* curve_dB, const CRect& size);
+};
+
 
 // --- custom view example
 const unsigned int MESSAGE_SHOW_CONTROL = 0;
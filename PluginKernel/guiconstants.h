@@ -34,6 +34,17 @@ const unsigned int SCALE_GUI_SIZE = 131077;		///<RESERVED PARAMETER ID VALUE
 //     const unsigned int CUSTOM_SPECTRUM_VIEW = CUSTOM_VIEW_BASE + 1;
 const unsigned int CUSTOM_VIEW_BASE = 132000;	///<ID values for Custom Views (not necessarily required)
 
+// --- user control IDs below this value are looked up through a dense table; the reserved IDs above stay in the map
+const unsigned int MAX_DENSE_CONTROL_ID = 4096;	///< size limit for the dense controlID lookup table
+
+// --- sample-accurate automation: buffers are split into at most this many sub-blocks at automation points
+const unsigned int MAX_AUTOMATION_SUBBLOCKS = 64;	///< sub-block limit per buffer; later points are applied at the last boundary (counted, see PluginBase::getLateAutomationPointCount( ))
+const unsigned int MAX_AUTOMATION_EVENTS = 512;		///< automation point limit per buffer; parameters that overflow are polled per-sample
+
+// --- block processing (PluginDescriptor::processBlocks): sub-blocks are further split into blocks of at most this many frames
+const unsigned int MAX_PROCESS_BLOCK_FRAMES = 64;	///< frames per processAudioBlock( ) call
+const unsigned int MAX_MIDI_EVENT_OFFSETS = 128;	///< distinct MIDI event offsets per buffer; beyond this MIDI is fired on every frame
+
 // --- enum for the GUI object's message processing
 enum { tinyGUI, verySmallGUI, smallGUI, normalGUI, largeGUI, veryLargeGUI };	///< GUI scaling constants
 
@@ -210,6 +221,7 @@ const float ENVELOPE_ANALOG_TC = -1.0023934309275667804345424248947; ///< ln(36.
 // ---
 const float GUI_METER_UPDATE_INTERVAL_MSEC = 50.f;	///< repaint interval; larger = slower
 const float GUI_METER_MIN_DB = -60.f;				///< min GUI value in dB
+const float GUI_METER_CHANGE_THRESHOLD = 0.002f;	///< normalized change below which a writeable control is not repainted
 /** @} */
 
 /** \ingroup Constants-Enums */
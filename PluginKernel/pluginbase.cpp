@@ -56,8 +56,11 @@ PluginBase::~PluginBase()
     pluginParameters.clear();
     pluginParameterMap.clear();
 	delete [] pluginParameterArray;
+	delete [] pluginParameterLookup;
 	delete [] smoothablePluginParameters;
 	delete [] outboundPluginParameters;
+	delete [] perSampleParameters;
+	delete [] perSamplePolled;
 }
 
 /**
@@ -98,11 +101,22 @@ bool PluginBase::initialize(PluginInfo& _pluginInfo)
 \brief initialize object for a new run of audio; called just before audio streams
 
 Operation:
-- iterate through parameters and copy their values into the bound variables you set up
+- acquire the newest ParameterSnapshot buffer; if nothing was published since the last buffer, there is nothing to do
+- iterate through parameters and copy their snapshot values into the bound variables you set up
 - then, call the postUpdatePluginParameter method to do any post-update cooking required to use the variable for processing
+
+NOTES:
+- all values come from one coherent snapshot, so a block never sees half of a multi-parameter GUI/host change
+- smoothed parameters (and meters) still read their atomics; smoothed values and VST sample-accurate values
+  are written to the bound variables in doSampleAccurateParameterUpdates( )
 */
 void PluginBase::syncInBoundVariables()
 {
+	// --- one atomic load when nothing changed
+	const float* snapshot = parameterSnapshot.acquire();
+	if (!snapshot)
+		return;
+
 	ParameterUpdateInfo info;
 	info.bufferProcUpdate = true;
 	info.boundVariableUpdate = true;
@@ -110,9 +124,18 @@ void PluginBase::syncInBoundVariables()
 	// --- rip through and synch em
 	for (unsigned int i = 0; i < numPluginParameters; i++)
 	{
-		if (pluginParameterArray[i] && pluginParameterArray[i]->updateInBoundVariable())
+		PluginParameter* piParam = pluginParameterArray[i];
+		if (!piParam)
+			continue;
+
+		if (piParam->getParameterSmoothing() || piParam->getControlVariableType() == controlVariableType::kMeter)
+		{
+			if (piParam->updateInBoundVariable())
+				postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), info);
+		}
+		else if (piParam->updateInBoundVariable(snapshot[i]))
 		{
-			postUpdatePluginParameter(pluginParameterArray[i]->getControlID(), pluginParameterArray[i]->getControlValue(), info);
+			postUpdatePluginParameter(piParam->getControlID(), snapshot[i], info);
 		}
 	}
 }
@@ -123,7 +146,17 @@ void PluginBase::syncInBoundVariables()
 Operation:
 - break channel buffers into frames (one sample from each channel, in and out)
 - call the pre-processing function on derived class to allow it to prepare for the audio buffer's arrival
+- split the buffer into sub-blocks at the sample-accurate automation points and apply each sub-block's updates at its first frame
 - call the frame processing function that the derived class MUST implement repeatedly until the buffer is processed
+- OR, if pluginDescriptor.processBlocks is set, call processAudioBlock( ) once per block of up to MAX_PROCESS_BLOCK_FRAMES
+  (blocks never span a sub-block boundary, so parameters are constant inside each block)
+- the MIDI queue is looked at once per buffer: with no events it is skipped entirely; otherwise blocks also break at
+  every event offset so events fire only at their own frame (queues that cannot report offsets are fired every frame,
+  in one-frame blocks, exactly as frame processing does)
+- the host's position is read once per buffer; hostInfo holds the top of the current block (or buffer, for frames) and
+  advances once per block; getAbsoluteFrameIndex( ) and getAbsoluteFrameTime( ) give any frame's position on demand
+- 64-bit host buffers (processBufferInfo.inputs64/outputs64) are passed straight through to processAudioBlock( );
+  frame processing is float only, so a double buffer without processBlocks is not processed
 - call the post-processing function on derived class to allow it to do any stuff that requires the buffer to be processed first
 - NOTE: if you want the derived class to process buffers instead of frames, override and implement THIS function in the derived class
 
@@ -138,9 +171,92 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 	memset(&auxInputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
 	memset(&auxOutputFrame, 0, sizeof(float)*MAX_CHANNEL_COUNT);
 
-	double sampleInterval = 1.0 / audioProcDescriptor.sampleRate;
+	// --- every position in this buffer is derived from here; time is index / sample rate, so it cannot drift
+	bufferStartFrameIndex = processBufferInfo.hostInfo->uAbsoluteFrameBufferIndex;
+
+	if (pluginDescriptor.processBlocks)
+	{
+		ProcessBlockInfo info;
+
+		info.inputs = processBufferInfo.inputs;
+		info.outputs = processBufferInfo.outputs;
+		info.auxInputs = processBufferInfo.auxInputs;
+		info.auxOutputs = processBufferInfo.auxOutputs;
+		info.inputs64 = processBufferInfo.inputs64;
+		info.outputs64 = processBufferInfo.outputs64;
+		info.auxInputs64 = processBufferInfo.auxInputs64;
+		info.auxOutputs64 = processBufferInfo.auxOutputs64;
+
+		info.channelIOConfig = processBufferInfo.channelIOConfig;
+		info.auxChannelIOConfig = processBufferInfo.auxChannelIOConfig;
+
+		info.numAudioInChannels = processBufferInfo.numAudioInChannels;
+		info.numAudioOutChannels = processBufferInfo.numAudioOutChannels;
+		info.numAuxAudioInChannels = processBufferInfo.numAuxAudioInChannels;
+		info.numAuxAudioOutChannels = processBufferInfo.numAuxAudioOutChannels;
+
+		info.hostInfo = processBufferInfo.hostInfo;
+		info.midiEventQueue = processBufferInfo.midiEventQueue;
+
+		// --- sync internal bound variables
+		preProcessAudioBuffers(processBufferInfo);
+
+		// --- automation points split the buffer; parameters are constant inside each sub-block
+		prepareAutomationSubBlocks(processBufferInfo.numFramesToProcess);
+
+		// --- MIDI event offsets split blocks further
+		prepareMidiEventOffsets(processBufferInfo.midiEventQueue, processBufferInfo.numFramesToProcess);
+		uint32_t nextMidiEvent = 0;
+
+		for (uint32_t subBlock = 0; subBlock < numSubBlocks; subBlock++)
+		{
+			applyAutomationSubBlock(subBlock);
+
+			uint32_t subBlockEnd = subBlockOffset[subBlock + 1];
+			for (uint32_t frame = subBlockOffset[subBlock]; frame < subBlockEnd; frame += info.numFrames)
+			{
+				uint32_t blockEnd = subBlockEnd - frame < MAX_PROCESS_BLOCK_FRAMES ? subBlockEnd : frame + MAX_PROCESS_BLOCK_FRAMES;
+
+				// --- every event offset starts a block, so events only ever fire on a block's first frame
+				info.numMidiFrames = 0;
+				if (nextMidiEvent < numMidiEventOffsets && midiEventOffset[nextMidiEvent] == frame)
+				{
+					info.numMidiFrames = 1;
+					nextMidiEvent++;
+				}
+				if (nextMidiEvent < numMidiEventOffsets && midiEventOffset[nextMidiEvent] < blockEnd)
+					blockEnd = midiEventOffset[nextMidiEvent];
+
+				// --- a poll-only queue advances one sample per getNextValue( ), so it must be polled once per frame; a MIDI
+				//     queue without offsets is fired once per frame, so each frame needs its own block to keep its timing
+				if (automationPolledPerFrame || midiEventsPerFrame)
+					blockEnd = frame + 1;
+
+				info.blockStartFrame = frame;
+				info.numFrames = blockEnd - frame;
+				if (midiEventsPerFrame)
+					info.numMidiFrames = 1;
+
+				// --- update per-block
+				info.hostInfo->uAbsoluteFrameBufferIndex = getAbsoluteFrameIndex(frame);
+				info.hostInfo->dAbsoluteFrameBufferTime = getAbsoluteFrameTime(frame);
+
+				// -- process the block of data
+				processAudioBlock(info);
+			}
+		}
+
+		// --- leave the host position at the end of the buffer
+		info.hostInfo->uAbsoluteFrameBufferIndex = getAbsoluteFrameIndex(processBufferInfo.numFramesToProcess);
+		info.hostInfo->dAbsoluteFrameBufferTime = getAbsoluteFrameTime(processBufferInfo.numFramesToProcess);
+
+		// --- generally not used
+		postProcessAudioBuffers(processBufferInfo);
+
+		return true; /// processed
+	}
 
-	if (pluginDescriptor.processFrames)
+	if (pluginDescriptor.processFrames && !processBufferInfo.outputs64)
 	{
 		ProcessFrameInfo info;
 
@@ -158,43 +274,54 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 		info.numAuxAudioOutChannels = processBufferInfo.numAuxAudioOutChannels;
 
 		info.hostInfo = processBufferInfo.hostInfo;
-		info.midiEventQueue = processBufferInfo.midiEventQueue;
+
+		// --- an empty MIDI queue is not handed on, so it is not fired on every frame
+		IMidiEventQueue* midiEventQueue = processBufferInfo.midiEventQueue;
+		info.midiEventQueue = midiEventQueue && midiEventQueue->getEventCount() > 0 ? midiEventQueue : nullptr;
 
 		// --- sync internal bound variables
 		preProcessAudioBuffers(processBufferInfo);
 
-		// --- build frames, one sample from each channel
-		for (uint32_t frame = 0; frame<processBufferInfo.numFramesToProcess; frame++)
+		// --- automation points split the buffer; parameters are constant inside each sub-block
+		prepareAutomationSubBlocks(processBufferInfo.numFramesToProcess);
+
+		for (uint32_t subBlock = 0; subBlock < numSubBlocks; subBlock++)
 		{
-			for (uint32_t i = 0; i<processBufferInfo.numAudioInChannels; i++)
-			{
-				inputFrame[i] = processBufferInfo.inputs[i][frame];
-			}
+			applyAutomationSubBlock(subBlock);
 
-			for (uint32_t i = 0; i<processBufferInfo.numAuxAudioInChannels; i++)
+			// --- build frames, one sample from each channel
+			for (uint32_t frame = subBlockOffset[subBlock]; frame < subBlockOffset[subBlock + 1]; frame++)
 			{
-				auxInputFrame[i] = processBufferInfo.auxInputs[i][frame];
-			}
+				for (uint32_t i = 0; i<processBufferInfo.numAudioInChannels; i++)
+				{
+					inputFrame[i] = processBufferInfo.inputs[i][frame];
+				}
 
-			info.currentFrame = frame;
+				for (uint32_t i = 0; i<processBufferInfo.numAuxAudioInChannels; i++)
+				{
+					auxInputFrame[i] = processBufferInfo.auxInputs[i][frame];
+				}
 
-			// -- process the frame of data
-			processAudioFrame(info);
+				info.currentFrame = frame;
 
-			for (uint32_t i = 0; i<processBufferInfo.numAudioOutChannels; i++)
-			{
-				processBufferInfo.outputs[i][frame] = outputFrame[i];
-			}
-			for (uint32_t i = 0; i<processBufferInfo.numAuxAudioOutChannels; i++)
-			{
-				processBufferInfo.auxOutputs[i][frame] = auxOutputFrame[i];
-			}
+				// -- process the frame of data
+				processAudioFrame(info);
 
-			// --- update per-frame
-			info.hostInfo->uAbsoluteFrameBufferIndex += 1;
-			info.hostInfo->dAbsoluteFrameBufferTime += sampleInterval;
+				for (uint32_t i = 0; i<processBufferInfo.numAudioOutChannels; i++)
+				{
+					processBufferInfo.outputs[i][frame] = outputFrame[i];
+				}
+				for (uint32_t i = 0; i<processBufferInfo.numAuxAudioOutChannels; i++)
+				{
+					processBufferInfo.auxOutputs[i][frame] = auxOutputFrame[i];
+				}
+			}
 		}
 
+		// --- hostInfo keeps the top of the buffer while frames run (see getAbsoluteFrameIndex( )); leave it at the end
+		info.hostInfo->uAbsoluteFrameBufferIndex = getAbsoluteFrameIndex(processBufferInfo.numFramesToProcess);
+		info.hostInfo->dAbsoluteFrameBufferTime = getAbsoluteFrameTime(processBufferInfo.numFramesToProcess);
+
 		// --- generally not used
 		postProcessAudioBuffers(processBufferInfo);
 
@@ -209,6 +336,7 @@ bool PluginBase::processAudioBuffers(ProcessBufferInfo& processBufferInfo)
 
 Operation:
 - simple loop to update meter variables
+- marks each meter that moved by more than GUI_METER_CHANGE_THRESHOLD in outboundDirtySet, so the GUI only repaints those
 - to display custom data (waveforms, histograms, etc...) see Custom Views example in ASPiK SDK
 
 \return true if at least one parameter was updated, false otherwise
@@ -223,6 +351,8 @@ bool PluginBase::updateOutBoundVariables()
 		if (outboundPluginParameters[i])
 		{
 			outboundPluginParameters[i]->updateOutBoundVariable();
+			if (outboundPluginParameters[i]->checkGUIValueChange(GUI_METER_CHANGE_THRESHOLD))
+				outboundDirtySet.markDirty(outboundPluginParameters[i]->getControlID());
 			updated = true; // sticky
 		}
 	}
@@ -232,20 +362,22 @@ bool PluginBase::updateOutBoundVariables()
 
 
 /**
-\brief combines parameter smoothing and VST3 sample accurate updates
+\brief combines parameter smoothing and VST3 sample accurate updates that can only be polled
 
 NOTE:
+- only walks the parameters prepareAutomationSubBlocks( ) found to need per-sample work this buffer: smoothing parameters
+  and parameters whose IParameterUpdateQueue cannot report its points; with neither, this returns immediately
+- queued automation points are NOT handled here; they are applied at the sub-block boundaries in applyAutomationSubBlock( )
+- must be called once per frame while automationPolledPerFrame is set (block processing then uses one-frame blocks)
 - beware: this function can eat a lot of CPU if the sample accurate updates trigger complex cooking functions
 - to combat CPU usage, you can set the VST3 sample granularity in initPluginDescriptors() apiSpecificInfo.vst3SampleAccurateGranularity
 - you can also change the parameter smoothing granularity
-- but in either case, the list MUST be iterated; this function is the reason for the old-fashioned C-array of pointers\n
-  as it was found to be faster than any other list method for entire-list iteration (if you have a faster way, let me knmow!)
 - the parameter is updated with the smoothed value
 - the post-parameter update function is then called (complex cooking functions here will eat the CPU as well)
 */
 void PluginBase::doSampleAccurateParameterUpdates()
 {
-	if (numSmoothablePluginParameters == 0)
+	if (numPerSampleParameters == 0)
 		return;
 
 	// --- do updates
@@ -258,44 +390,209 @@ void PluginBase::doSampleAccurateParameterUpdates()
 	paramSmoothUpdate.isSmoothing = true;
 
 	// --- rip through the array
-	for (unsigned int i = 0; i < numSmoothablePluginParameters; i++)
+	for (unsigned int i = 0; i < numPerSampleParameters; i++)
 	{
-		PluginParameter* piParam = smoothablePluginParameters[i];
-		if (piParam)
+		PluginParameter* piParam = perSampleParameters[i];
+
+		// --- VST sample accurate stuff, for queues that can only be polled
+		if (perSamplePolled[i])
 		{
-			// --- VST sample accurate stuff
-			if (wantsVST3SampleAccurateAutomation())
+			if (piParam->getParameterUpdateQueue()->getNextValue(value))
 			{
-				// --- if we get here getParameterUpdateQueue() should be non-null
-				//     NOTE you can disable sample accurate automation for each parameter when you set them up if needed
-				if (piParam->getParameterUpdateQueue() && piParam->getEnableVSTSampleAccurateAutomation())
+				piParam->setControlValueNormalized(value, false, true, false); // false = do not apply taper, true = ignore smoothing (not needed here), false = bound variable updated below, no publish
+				vstSAAutomated = true;
+
+				// --- now update the bound variable
+				if (piParam->updateInBoundVariable())
 				{
-					if (piParam->getParameterUpdateQueue()->getNextValue(value))
-					{
-						piParam->setControlValueNormalized(value, false, true); // false = do not apply taper, true = ignore smoothing (not needed here)
-						vstSAAutomated = true;
-
-						// --- now update the bound variable
-						if (piParam->updateInBoundVariable())
-						{
-							vst3Update.boundVariableUpdate = true;
-						}
-						postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), vst3Update);
-					}
+					vst3Update.boundVariableUpdate = true;
 				}
+				postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), vst3Update);
 			}
+		}
 
-			// --- do smoothing, but not if we did a sample accurate automation update!
-			if (!vstSAAutomated && piParam->smoothParameterValue())
+		// --- do smoothing, but not if we did a sample accurate automation update!
+		if (!vstSAAutomated && piParam->smoothParameterValue())
+		{
+			// --- update bound variable, if there is one
+			if (piParam->updateInBoundVariable())
 			{
-				// --- update bound variable, if there is one
-				if (piParam->updateInBoundVariable())
+				paramSmoothUpdate.boundVariableUpdate = true;
+			}
+			postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), paramSmoothUpdate);
+		}
+	}
+}
+
+/**
+\brief collects this buffer's sample accurate automation points and splits the buffer into sub-blocks
+
+Operation:
+- one walk over the smoothable parameters per buffer (instead of one per sample)
+- queues that report their points (IParameterUpdateQueue::getPointCount( ) >= 0) become AutomationEvents, sorted by offset
+- each distinct offset starts a new sub-block, up to MAX_AUTOMATION_SUBBLOCKS; later points are applied at the last
+  boundary and counted in getLateAutomationPointCount( )
+- only queues that override getPointCount( ) are split this way (ParameterPointQueue is one); the IParameterUpdateQueue
+  default reports -1, so a shell that hands over poll-only queues gets one-frame blocks instead of sub-blocks
+- smoothing parameters, poll-only queues and parameters that overflow MAX_AUTOMATION_EVENTS go on the per-sample list
+  walked by doSampleAccurateParameterUpdates( )
+- any polled queue sets automationPolledPerFrame: block processing then runs one-frame blocks for this buffer, so
+  doSampleAccurateParameterUpdates( ) polls once per sample and each value lands on its own frame
+
+\param numFrames the number of frames in this buffer
+*/
+void PluginBase::prepareAutomationSubBlocks(uint32_t numFrames)
+{
+	numAutomationEvents = 0;
+	numPerSampleParameters = 0;
+	automationPolledPerFrame = false;
+
+	bool sampleAccurate = wantsVST3SampleAccurateAutomation();
+	for (unsigned int i = 0; i < numSmoothablePluginParameters; i++)
+	{
+		PluginParameter* piParam = smoothablePluginParameters[i];
+		if (!piParam)
+			continue;
+
+		bool polled = false;
+		IParameterUpdateQueue* queue = piParam->getParameterUpdateQueue();
+		if (sampleAccurate && queue && piParam->getEnableVSTSampleAccurateAutomation() && numFrames > 0)
+		{
+			int32_t pointCount = queue->getPointCount();
+			if (pointCount < 0 || numAutomationEvents + (uint32_t)pointCount > MAX_AUTOMATION_EVENTS)
+				polled = true;
+			else
+			{
+				for (int32_t p = 0; p < pointCount; p++)
 				{
-					paramSmoothUpdate.boundVariableUpdate = true;
+					int32_t offset = 0;
+					double value = 0.0;
+					if (!queue->getPoint(p, offset, value))
+						continue;
+
+					// --- insertion sort; stable so two points at one offset keep their queue order
+					uint32_t sampleOffset = offset < 0 ? 0 : ((uint32_t)offset >= numFrames ? numFrames - 1 : (uint32_t)offset);
+					uint32_t n = numAutomationEvents++;
+					while (n > 0 && automationEvents[n - 1].sampleOffset > sampleOffset)
+					{
+						automationEvents[n] = automationEvents[n - 1];
+						n--;
+					}
+					automationEvents[n].parameter = piParam;
+					automationEvents[n].sampleOffset = sampleOffset;
+					automationEvents[n].normalizedValue = value;
 				}
-				postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), paramSmoothUpdate);
 			}
 		}
+
+		automationPolledPerFrame = automationPolledPerFrame || polled;
+		if (polled || piParam->getParameterSmoothing())
+		{
+			perSamplePolled[numPerSampleParameters] = polled;
+			perSampleParameters[numPerSampleParameters++] = piParam;
+		}
+	}
+
+	// --- sub-block 0 always starts at frame 0; every new offset opens a sub-block while there is room
+	numSubBlocks = 1;
+	subBlockOffset[0] = 0;
+	subBlockFirstEvent[0] = 0;
+	uint32_t numLatePoints = 0;
+	for (uint32_t e = 0; e < numAutomationEvents; e++)
+	{
+		if (automationEvents[e].sampleOffset == subBlockOffset[numSubBlocks - 1])
+			continue;
+
+		if (numSubBlocks < MAX_AUTOMATION_SUBBLOCKS)
+		{
+			subBlockOffset[numSubBlocks] = automationEvents[e].sampleOffset;
+			subBlockFirstEvent[numSubBlocks] = e;
+			numSubBlocks++;
+		}
+		else
+			numLatePoints++;
+	}
+	if (numLatePoints > 0)
+		lateAutomationPoints.store(lateAutomationPoints.load(std::memory_order_relaxed) + numLatePoints, std::memory_order_relaxed);	// audio thread is the only writer
+	subBlockOffset[numSubBlocks] = numFrames;
+	subBlockFirstEvent[numSubBlocks] = numAutomationEvents;
+}
+
+/**
+\brief collects this buffer's MIDI event offsets so block processing can fire each event at its own frame
+
+Operation:
+- getEventCount( ) once per buffer; an empty queue leaves no offsets and is never fired
+- distinct offsets from IMidiEventQueue::getEventSampleOffset( ), ascending; processAudioBuffers( ) starts a block at each one
+- a queue that cannot report an offset, or more than MAX_MIDI_EVENT_OFFSETS distinct offsets, falls back to firing on
+  every frame in one-frame blocks (as frame processing does)
+
+\param midiEventQueue this buffer's queue; may be nullptr
+\param numFrames the number of frames in this buffer
+*/
+void PluginBase::prepareMidiEventOffsets(IMidiEventQueue* midiEventQueue, uint32_t numFrames)
+{
+	numMidiEventOffsets = 0;
+	midiEventsPerFrame = false;
+
+	uint32_t eventCount = midiEventQueue && numFrames > 0 ? midiEventQueue->getEventCount() : 0;
+	for (uint32_t e = 0; e < eventCount; e++)
+	{
+		uint32_t sampleOffset = 0;
+		if (!midiEventQueue->getEventSampleOffset(e, sampleOffset))
+		{
+			numMidiEventOffsets = 0;
+			midiEventsPerFrame = true;
+			return;
+		}
+		if (sampleOffset >= numFrames)
+			sampleOffset = numFrames - 1;
+
+		// --- insertion into the ascending set; several events at one offset share an entry
+		uint32_t n = numMidiEventOffsets;
+		while (n > 0 && midiEventOffset[n - 1] > sampleOffset)
+			n--;
+		if (n > 0 && midiEventOffset[n - 1] == sampleOffset)
+			continue;
+
+		if (numMidiEventOffsets >= MAX_MIDI_EVENT_OFFSETS)
+		{
+			numMidiEventOffsets = 0;
+			midiEventsPerFrame = true;
+			return;
+		}
+		for (uint32_t m = numMidiEventOffsets; m > n; m--)
+			midiEventOffset[m] = midiEventOffset[m - 1];
+		midiEventOffset[n] = sampleOffset;
+		numMidiEventOffsets++;
+	}
+}
+
+/**
+\brief applies the automation points of one sub-block, just before its first frame is processed
+
+\param subBlock index of the sub-block, 0 to numSubBlocks - 1
+*/
+void PluginBase::applyAutomationSubBlock(uint32_t subBlock)
+{
+	uint32_t lastEvent = subBlockFirstEvent[subBlock + 1];
+	if (subBlockFirstEvent[subBlock] == lastEvent)
+		return;
+
+	ParameterUpdateInfo vst3Update(false, true); /// false = this is NOT called from smoothing operation, true: this is a VST sample accurate update
+	vst3Update.isVSTSampleAccurateUpdate = true;
+
+	for (uint32_t e = subBlockFirstEvent[subBlock]; e < lastEvent; e++)
+	{
+		PluginParameter* piParam = automationEvents[e].parameter;
+		piParam->setControlValueNormalized(automationEvents[e].normalizedValue, false, true, false); // false = do not apply taper, true = ignore smoothing, false = bound variable updated below, no publish
+
+		// --- now update the bound variable
+		if (piParam->updateInBoundVariable())
+		{
+			vst3Update.boundVariableUpdate = true;
+		}
+		postUpdatePluginParameter(piParam->getControlID(), piParam->getControlValue(), vst3Update);
 	}
 }
 
@@ -304,20 +601,30 @@ void PluginBase::doSampleAccurateParameterUpdates()
 
 NOTE:
 - initializes parameter smoothing (if enabled for that parameter)
+- a controlID that is already taken is an error (e.g. the same control declared twice); the parameter is deleted and
+  -1 returned, rather than left out of the map but still in the vector
 
-\param piParam pointer to a newly created plugin parameter
+\param piParam pointer to a newly created plugin parameter; owned by the plugin from here on
 \param sampleRate the sample rate, needed to initialize the smoother
 
-\return the index of the parameter in the vector or old-fashioned C-array
+\return the index of the parameter in the vector or old-fashioned C-array, or -1 if the controlID was taken
 */
 int32_t PluginBase::addPluginParameter(PluginParameter* piParam, double sampleRate)
 {
 	// --- map for controlID-indexing
-	pluginParameterMap.insert(std::make_pair(piParam->getControlID(), piParam));
+	if (!pluginParameterMap.insert(std::make_pair(piParam->getControlID(), piParam)).second)
+	{
+		delete piParam;
+		return -1;
+	}
 
 	// --- vector for fast iteration and 0-indexing
 	pluginParameters.push_back(piParam);
 
+	// --- late addition: keep the dense lookup table coherent (IDs past its end use the map)
+	if (piParam->getControlID() < pluginParameterLookupSize)
+		pluginParameterLookup[piParam->getControlID()] = piParam;
+
 	// --- first intialization, this can change
 	piParam->initParamSmoother(sampleRate);
 
@@ -651,6 +958,7 @@ void PluginBase::clearUpdateGUIParameters(std::vector<GUIParameter*>& guiParamet
 
 /**
 \brief copies parameters into a new list; used to initialize the GUI - note that this makes true, disconnected copies
+(values and bindings; the read-only name/string-list metadata is shared, copy-on-write)
 
 \param disableSmoothing turn off smoothing in copied parameters
 
@@ -810,8 +1118,27 @@ void PluginBase::initPluginParameterArray()
 	numOutboundPluginParameters = 0;
 
 	pluginParameterArray = new PluginParameter*[numPluginParameters];
+
+	// --- dense controlID -> parameter table, sized by the largest non-reserved control ID
+	if (pluginParameterLookup)
+		delete[] pluginParameterLookup;
+
+	pluginParameterLookupSize = 0;
 	for (unsigned int i = 0; i < numPluginParameters; i++)
 	{
+		uint32_t controlID = pluginParameters[i]->getControlID();
+		if (controlID < MAX_DENSE_CONTROL_ID && controlID >= pluginParameterLookupSize)
+			pluginParameterLookupSize = controlID + 1;
+	}
+
+	pluginParameterLookup = new PluginParameter*[pluginParameterLookupSize];
+	memset(pluginParameterLookup, 0, sizeof(PluginParameter*)*pluginParameterLookupSize);
+
+	for (unsigned int i = 0; i < numPluginParameters; i++)
+	{
+		if (pluginParameters[i]->getControlID() < pluginParameterLookupSize)
+			pluginParameterLookup[pluginParameters[i]->getControlID()] = pluginParameters[i];
+
 		pluginParameterArray[i] = pluginParameters[i];
 
 		// --- how many are potentially smoothable?
@@ -840,6 +1167,16 @@ void PluginBase::initPluginParameterArray()
 		}
 	}
 
+	// --- per-sample list for doSampleAccurateParameterUpdates( ); a subset of the smoothable list, filled per buffer
+	if (perSampleParameters)
+		delete[] perSampleParameters;
+	if (perSamplePolled)
+		delete[] perSamplePolled;
+
+	perSampleParameters = new PluginParameter*[numSmoothablePluginParameters > 0 ? numSmoothablePluginParameters : 1];
+	perSamplePolled = new bool[numSmoothablePluginParameters > 0 ? numSmoothablePluginParameters : 1];
+	numPerSampleParameters = 0;
+
 	if (outboundPluginParameters)
 		delete[] outboundPluginParameters;
 
@@ -854,6 +1191,12 @@ void PluginBase::initPluginParameterArray()
 		}
 	}
 
+	// --- one snapshot slot per parameter, indexed like pluginParameterArray; seed and publish the initial values
+	parameterSnapshot.create(numPluginParameters);
+	for (unsigned int i = 0; i < numPluginParameters; i++)
+		pluginParameterArray[i]->setParameterSnapshot(&parameterSnapshot, i);
+
+	parameterSnapshot.publish();
 }
 
 /**
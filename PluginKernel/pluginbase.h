@@ -196,6 +196,25 @@ The AAX plugin shell consists of the following files:
 
 #include <map>
 
+/**
+\struct AutomationEvent
+\ingroup Structures
+\brief
+One sample-accurate automation point collected from an IParameterUpdateQueue at the top of a buffer.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct AutomationEvent
+{
+	AutomationEvent() {}
+
+	PluginParameter* parameter = nullptr;	///< parameter to update
+	uint32_t sampleOffset = 0;				///< offset in the buffer where the new value takes effect
+	double normalizedValue = 0.0;			///< new normalized value (taper already applied by the host)
+};
+
 /**
 \class PluginBase
 \ingroup ASPiK-Core
@@ -256,9 +275,15 @@ public:
 	/** Buffer Proc Cycle: II PluginCore overrides this method to process frames */
 	virtual bool processAudioBuffers(ProcessBufferInfo& processInfo);
 
+	/** Buffer Proc Cycle: II (block version) PluginCore overrides this method to process blocks when pluginDescriptor.processBlocks is set; base class implementation is empty */
+	virtual bool processAudioBlock(ProcessBlockInfo& processBlockInfo) { return false; }
+
 	/** Buffer Proc Cycle: III connects meter variables to outbound GUI control changes (part of ASPiK output variable binding option) */
 	bool updateOutBoundVariables();
 
+	/** controlIDs of the meters updateOutBoundVariables( ) found to have moved; the shell hands this to the GUI */
+	ControlDirtySet* getOutboundDirtySet() { return &outboundDirtySet; }
+
 	/** notification that a GUI parameter changed. NOT for updating internal states or variables; unused at base class level */
 	virtual bool guiParameterChanged(int32_t controlID, double actualValue) { return true; }
 
@@ -268,9 +293,22 @@ public:
 	/** ASPiK midi event system: base class implementation is empty */
 	virtual bool processMIDIEvent(midiEvent& event) { return true; }
 
-	/** perform parameter smoothing or VST3 sample accurate upates */
+	/** perform per-sample parameter smoothing and polled VST3 sample accurate upates (queued points are applied at sub-block boundaries) */
 	void doSampleAccurateParameterUpdates();
 
+	/** collect this buffer's automation points and split it into sub-blocks; called once per buffer */
+	void prepareAutomationSubBlocks(uint32_t numFrames);
+
+	/** apply the automation points that start sub-block number subBlock */
+	void applyAutomationSubBlock(uint32_t subBlock);
+
+	/** automation points applied late, at the last sub-block boundary, because a buffer had more distinct offsets than
+	    MAX_AUTOMATION_SUBBLOCKS; counts since construction, safe to read from any thread */
+	uint32_t getLateAutomationPointCount() { return lateAutomationPoints.load(std::memory_order_relaxed); }
+
+	/** collect this buffer's distinct MIDI event offsets for block processing; called once per buffer */
+	void prepareMidiEventOffsets(IMidiEventQueue* midiEventQueue, uint32_t numFrames);
+
 	/** only for a vector joystick control from DAW that implements it (reserved for future use): base class implementation is empty */
 	virtual bool setVectorJoystickParameters(const VectorJoystickData& vectorJoysickData) { return true; }
 
@@ -293,13 +331,24 @@ public:
 	PluginParameter* getPluginParameterByIndex(int32_t index) { return pluginParameters[index]; }
 
 	/**
-	\brief get a parameter by control ID - uses map (slowest)
+	\brief get a parameter by control ID - uses the dense controlID table built in initPluginParameterArray( );
+	IDs outside the table (e.g. SCALE_GUI_SIZE) and lookups made before the table exists fall back to the map.
+	Never allocates and never inserts on a miss.
 
 	\param controlID the control ID of the parameter
 
-	\return a naked pointer to the PluginParameter object
+	\return a naked pointer to the PluginParameter object, or nullptr if there is no parameter with this ID
 	*/
-	PluginParameter* getPluginParameterByControlID(int32_t controlID) { return pluginParameterMap[controlID]; }
+	PluginParameter* getPluginParameterByControlID(int32_t controlID)
+	{
+		// --- O(1) for the (normally small) control IDs
+		if ((uint32_t)controlID < pluginParameterLookupSize)
+			return pluginParameterLookup[controlID];
+
+		// --- sparse IDs: find, never operator[ ]
+		pluginParameterControlIDMap::const_iterator it = pluginParameterMap.find(controlID);
+		return it != pluginParameterMap.end() ? it->second : nullptr;
+	}
 
 	/** get a parameter by type - used to find all meter variables for writing to GUI */
 	PluginParameter* getNextParameterOfType(int32_t& startIndex, controlVariableType controlType);
@@ -500,6 +549,23 @@ public:
 	*/
 	double getSampleRate() { return audioProcDescriptor.sampleRate; }
 
+	/**
+	\brief Position query: absolute sample index of a frame in the buffer being processed
+
+	\param bufferFrame frame index within the current buffer (ProcessFrameInfo::currentFrame, or blockStartFrame + n)
+	\return the host's sample index at the top of the buffer plus bufferFrame
+	*/
+	unsigned long long getAbsoluteFrameIndex(uint32_t bufferFrame) { return bufferStartFrameIndex + bufferFrame; }
+
+	/**
+	\brief Position query: absolute time of a frame in the buffer being processed; derived from the sample index, so it
+	does not drift however long the session runs
+
+	\param bufferFrame frame index within the current buffer (ProcessFrameInfo::currentFrame, or blockStartFrame + n)
+	\return the time in seconds
+	*/
+	double getAbsoluteFrameTime(uint32_t bufferFrame) { return (double)(bufferStartFrameIndex + bufferFrame) / audioProcDescriptor.sampleRate; }
+
 	/**
 	\brief Description query: 4-char code
 
@@ -588,6 +654,7 @@ protected:
     PluginDescriptor pluginDescriptor;			///< description strings
     APISpecificInfo apiSpecificInfo;			///< description strings, API specific
 	AudioProcDescriptor audioProcDescriptor;	///< current audio processing description
+	unsigned long long bufferStartFrameIndex = 0;	///< HostInfo::uAbsoluteFrameBufferIndex at the top of the current buffer
 	PluginInfo pluginInfo;						///< info about the DLL (component) itself, includes path to DLL
 
     // --- arrays for frame processing
@@ -603,6 +670,27 @@ protected:
 	uint32_t numSmoothablePluginParameters = 0;					///< number of smoothable parameters only
 	PluginParameter** outboundPluginParameters = nullptr;		///< old-fashioned C-arrays of pointers for outbound (meter) parameters
 	uint32_t numOutboundPluginParameters = 0;					///< total number of outbound (meter) parameters
+	PluginParameter** pluginParameterLookup = nullptr;			///< dense controlID-indexed table for O(1) lookup; nullptr for unused IDs
+	uint32_t pluginParameterLookupSize = 0;						///< highest dense control ID + 1 (0 until initPluginParameterArray( ))
+	ParameterSnapshot parameterSnapshot;						///< lock-free GUI/host -> audio thread parameter hand-off, read in syncInBoundVariables( )
+	ControlDirtySet outboundDirtySet;							///< lock-free audio thread -> GUI set of meters that moved, written in updateOutBoundVariables( )
+
+	// --- sample accurate automation, rebuilt once per buffer in prepareAutomationSubBlocks( )
+	PluginParameter** perSampleParameters = nullptr;			///< parameters that still need per-sample work (smoothing or poll-only queues)
+	bool* perSamplePolled = nullptr;							///< parallel to perSampleParameters: true if the queue is polled per-sample
+	uint32_t numPerSampleParameters = 0;						///< number of active per-sample parameters this buffer
+	bool automationPolledPerFrame = false;						///< a queue can only be polled: block processing runs one frame per block
+	AutomationEvent automationEvents[MAX_AUTOMATION_EVENTS];	///< this buffer's automation points, sorted by offset
+	uint32_t numAutomationEvents = 0;							///< number of automation points this buffer
+	uint32_t subBlockOffset[MAX_AUTOMATION_SUBBLOCKS + 1];		///< sub-block start offsets; [numSubBlocks] = buffer length
+	uint32_t subBlockFirstEvent[MAX_AUTOMATION_SUBBLOCKS + 1];	///< index of the first automation point of each sub-block
+	uint32_t numSubBlocks = 0;									///< number of sub-blocks this buffer (>= 1 when frames are processed)
+	std::atomic<uint32_t> lateAutomationPoints{ 0 };			///< points that found no free sub-block (audio thread writes, anyone reads)
+
+	// --- MIDI event offsets for block processing, rebuilt once per buffer in prepareMidiEventOffsets( )
+	uint32_t midiEventOffset[MAX_MIDI_EVENT_OFFSETS];			///< distinct event offsets, ascending
+	uint32_t numMidiEventOffsets = 0;							///< number of distinct event offsets this buffer
+	bool midiEventsPerFrame = false;							///< the queue has events but cannot report their offsets: one-frame blocks, fired every frame
 
     // --- vectorized version of pluginParameterMap for fast iteration when key not needed
     std::vector<PluginParameter*> pluginParameters;				///< vector version of parameter list
@@ -10,6 +10,7 @@
     		- http://www.willpirkle.com
 */
 // -----------------------------------------------------------------------------
+#include <cassert>
 #include "plugincore.h"
 #include "plugindescription.h"
 
@@ -50,8 +51,55 @@ PluginCore::PluginCore()
 
     // --- create the presets
     initPluginPresets();
+
+	// --- the filter/detector state of both objects lives in our arena; kDSPArenaBiquads/kDSPArenaDetectors
+	//     are sized for exactly these two, so a failure means the sizing is stale. Release builds still run:
+	//     an object that did not bind falls back to its own arena in reset( )
+	const bool splitterBound = fourwaybandSplitter.bindToArena(dspArena.get());
+	const bool modFilterBound = modFilter.bindToArena(dspArena.get());
+	assert(splitterBound && "DSPStateArena too small for FourWayBandSplitter");
+	assert(modFilterBound && "DSPStateArena too small for ModFilter");
+	(void)splitterBound;
+	(void)modFilterBound;
+
+	// --- one set of graph block buffers, sized for the largest signal flow, shared by both graphs; after this,
+	//     rebuilding the graphs on the audio thread never allocates
+	processingGraph.setArena(&graphArena);
+	processingGraph64.setArena(&graphArena);
+	uint32_t numBlockBuffers = 1;
+	for (int flow = 0; flow <= (int)signalFlowEnum::Parallel; flow++)
+	{
+		describeSignalFlow(processingGraph, flow);
+		if (processingGraph.getNumBlockBuffers() > numBlockBuffers)
+			numBlockBuffers = processingGraph.getNumBlockBuffers();
+	}
+	graphArena.reserve(numBlockBuffers);
+	buildProcessingGraph();
+
+#ifdef ENABLE_STAGE_PROFILING
+	processingGraph.setProfiler(&stageProfiler, kMix);
+	processingGraph64.setProfiler(&stageProfiler, kMix);
+	stageProfiler.setTraceRecorder(&traceRecorder);
+#endif
 }
 
+/**
+\struct PluginCoreParameter
+\ingroup Structures
+\brief
+One entry of PluginCore's constexpr parameter table: the shared description plus the member it binds to.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct PluginCoreParameter
+{
+	PluginParameterDescriptor descriptor;	///< the shared description
+	double PluginCore::* doubleVariable;	///< bound member for kDouble controls, else nullptr
+	int PluginCore::* intVariable;			///< bound member for string-list (kInt) controls, else nullptr
+};
+
 /**
 \brief create all of your plugin parameters here
 
@@ -66,429 +114,117 @@ bool PluginCore::initPluginParameters()
 	// **--0xDEA7--**
 
 
-	// --- Declaration of Plugin Parameter Objects 
-	PluginParameter* piParam = nullptr;
-
-	// --- discrete control: Split Select
-	piParam = new PluginParameter(controlID::splitSelect, "Split Select", "Splitter,LPF,Low Band,High Band,HPF", "Splitter");
-	piParam->setBoundVariable(&splitSelect, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Low_Split
-	piParam = new PluginParameter(controlID::splitLow, "Low_Split", "Hertz", controlVariableType::kDouble, 50.000000, 2000.000000, 400.000000, taper::kVoltOctaveTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&splitLow, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: High Split
-	piParam = new PluginParameter(controlID::splitHigh, "High Split", "Hertz", controlVariableType::kDouble, 5000.000000, 20000.000000, 10000.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&splitHigh, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Mid Split
-	piParam = new PluginParameter(controlID::midSplit, "Mid Split", "Hertz", controlVariableType::kDouble, 300.000000, 12000.000000, 1000.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&midSplit, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: LPF Volume
-	piParam = new PluginParameter(controlID::lpfVolume, "LPF Volume", "dB", controlVariableType::kDouble, -60.000000, 6.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lpfVolume, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Low Band Volume
-	piParam = new PluginParameter(controlID::lowbandVolume, "Low Band Volume", "dB", controlVariableType::kDouble, -60.000000, 6.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lowbandVolume, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: High Band Volume
-	piParam = new PluginParameter(controlID::highbandVolume, "High Band Volume", "dB", controlVariableType::kDouble, -60.000000, 6.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&highbandVolume, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: HPF Volume
-	piParam = new PluginParameter(controlID::hpfVolume, "HPF Volume", "dB", controlVariableType::kDouble, -60.000000, 6.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&hpfVolume, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: LPF Saturation
-	piParam = new PluginParameter(controlID::lpfSaturation, "LPF Saturation", "Units", controlVariableType::kDouble, 1.000000, 10.000000, 1.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lpfSaturation, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Low Band Saturation
-	piParam = new PluginParameter(controlID::lowbandSaturation, "Low Band Saturation", "Units", controlVariableType::kDouble, 1.000000, 10.000000, 1.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lowbandSaturation, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: High Band Saturation
-	piParam = new PluginParameter(controlID::highbandSaturation, "High Band Saturation", "Units", controlVariableType::kDouble, 1.000000, 10.000000, 1.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&highbandSaturation, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: HPF Saturation
-	piParam = new PluginParameter(controlID::hpfSaturation, "HPF Saturation", "Units", controlVariableType::kDouble, 1.000000, 10.000000, 1.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&hpfSaturation, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Dry Volume
-	piParam = new PluginParameter(controlID::dryVolume, "Dry Volume", "dB", controlVariableType::kDouble, -15.000000, 0.000000, -15.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&dryVolume, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: ModFilter Cutoff
-	piParam = new PluginParameter(controlID::fcModFilter, "ModFilter Cutoff", "Hertz", controlVariableType::kDouble, 80.000000, 5000.000000, 800.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&fcModFilter, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: ModFilter Q
-	piParam = new PluginParameter(controlID::qModFilter, "ModFilter Q", "Units", controlVariableType::kDouble, 0.500000, 10.000000, 2.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&qModFilter, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Threshold
-	piParam = new PluginParameter(controlID::threshold_db, "Threshold", "dB", controlVariableType::kDouble, -30.000000, 0.000000, -15.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&threshold_db, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Attack
-	piParam = new PluginParameter(controlID::attack_ms, "Attack", "ms", controlVariableType::kDouble, 1.000000, 10.000000, 8.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&attack_ms, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Release
-	piParam = new PluginParameter(controlID::release_ms, "Release", "ms", controlVariableType::kDouble, 20.000000, 400.000000, 80.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&release_ms, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Sensitivity
-	piParam = new PluginParameter(controlID::sensitivity, "Sensitivity", "Units", controlVariableType::kDouble, 0.250000, 5.000000, 1.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&sensitivity, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Enable Splitter
-	piParam = new PluginParameter(controlID::enableSplit, "Enable Splitter", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableSplit, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Enable ModFilter
-	piParam = new PluginParameter(controlID::enableModFilter, "Enable ModFilter", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableModFilter, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: ModFilter Type
-	piParam = new PluginParameter(controlID::typeModFilter, "ModFilter Type", "LPF,Band,HPF", "LPF");
-	piParam->setBoundVariable(&typeModFilter, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Boost
-	piParam = new PluginParameter(controlID::filterBoost, "Boost", "dB", controlVariableType::kDouble, -5.000000, 10.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&filterBoost, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Dry Filter
-	piParam = new PluginParameter(controlID::dryFilter, "Dry Filter", "dB", controlVariableType::kDouble, -15.000000, 0.000000, -15.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&dryFilter, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Enable LFO
-	piParam = new PluginParameter(controlID::enableLFO, "Enable LFO", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableLFO, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- continuous control: LFO Rate
-	piParam = new PluginParameter(controlID::lfoRate, "LFO Rate", "Hz", controlVariableType::kDouble, 2.000000, 15.000000, 8.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lfoRate, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- continuous control: LFO Depth
-	piParam = new PluginParameter(controlID::lfoDepth, "LFO Depth", "Units", controlVariableType::kDouble, 0.000000, 100.000000, 50.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&lfoDepth, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Up/Down
-	piParam = new PluginParameter(controlID::invertFilterMod, "Up/Down", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&invertFilterMod, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Coupled Q
-	piParam = new PluginParameter(controlID::coupleQ, "Coupled Q", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&coupleQ, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Enable Double
-	piParam = new PluginParameter(controlID::enableDouble, "Enable Double", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableDouble, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- continuous control: Splitter Boost
-	piParam = new PluginParameter(controlID::splitterBoost, "Splitter Boost", "dB", controlVariableType::kDouble, -5.000000, 10.000000, 0.000000, taper::kLinearTaper);
-	piParam->setParameterSmoothing(false);
-	piParam->setSmoothingTimeMsec(100.00);
-	piParam->setBoundVariable(&splitterBoost, boundVariableType::kDouble);
-	addPluginParameter(piParam);
-
-	// --- discrete control: Signal Flow
-	piParam = new PluginParameter(controlID::signalFlow, "Signal Flow", "Splitter Filter,Filter Splitter,Parallel", "Splitter Filter");
-	piParam->setBoundVariable(&signalFlow, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: lfoDestination
-	piParam = new PluginParameter(controlID::m_uMySwitchVariable, "lfoDestination", "Fc,Q,Threshold", "Fc");
-	piParam->setBoundVariable(&m_uMySwitchVariable, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: SampleQ
-	piParam = new PluginParameter(controlID::enableQMod, "SampleQ", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableQMod, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- discrete control: SampleThreshold
-	piParam = new PluginParameter(controlID::enableThreshMod, "SampleThreshold", "SWITCH OFF,SWITCH ON", "SWITCH OFF");
-	piParam->setBoundVariable(&enableThreshMod, boundVariableType::kInt);
-	piParam->setIsDiscreteSwitch(true);
-	addPluginParameter(piParam);
-
-	// --- Aux Attributes
-	AuxParameterAttribute auxAttribute;
-
-	// --- RAFX GUI attributes
-	// --- controlID::splitSelect
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(805306368);
-	setParamAuxAttribute(controlID::splitSelect, auxAttribute);
-
-	// --- controlID::splitLow
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::splitLow, auxAttribute);
-
-	// --- controlID::splitHigh
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::splitHigh, auxAttribute);
-
-	// --- controlID::midSplit
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::midSplit, auxAttribute);
-
-	// --- controlID::lpfVolume
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lpfVolume, auxAttribute);
-
-	// --- controlID::lowbandVolume
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lowbandVolume, auxAttribute);
-
-	// --- controlID::highbandVolume
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::highbandVolume, auxAttribute);
-
-	// --- controlID::hpfVolume
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::hpfVolume, auxAttribute);
-
-	// --- controlID::lpfSaturation
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lpfSaturation, auxAttribute);
-
-	// --- controlID::lowbandSaturation
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lowbandSaturation, auxAttribute);
-
-	// --- controlID::highbandSaturation
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::highbandSaturation, auxAttribute);
-
-	// --- controlID::hpfSaturation
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::hpfSaturation, auxAttribute);
-
-	// --- controlID::dryVolume
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::dryVolume, auxAttribute);
-
-	// --- controlID::fcModFilter
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::fcModFilter, auxAttribute);
-
-	// --- controlID::qModFilter
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::qModFilter, auxAttribute);
-
-	// --- controlID::threshold_db
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::threshold_db, auxAttribute);
-
-	// --- controlID::attack_ms
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::attack_ms, auxAttribute);
-
-	// --- controlID::release_ms
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::release_ms, auxAttribute);
-
-	// --- controlID::sensitivity
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::sensitivity, auxAttribute);
-
-	// --- controlID::enableSplit
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableSplit, auxAttribute);
-
-	// --- controlID::enableModFilter
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableModFilter, auxAttribute);
-
-	// --- controlID::typeModFilter
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(805306368);
-	setParamAuxAttribute(controlID::typeModFilter, auxAttribute);
-
-	// --- controlID::filterBoost
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::filterBoost, auxAttribute);
-
-	// --- controlID::dryFilter
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::dryFilter, auxAttribute);
-
-	// --- controlID::enableLFO
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableLFO, auxAttribute);
-
-	// --- controlID::lfoRate
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lfoRate, auxAttribute);
-
-	// --- controlID::lfoDepth
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::lfoDepth, auxAttribute);
-
-	// --- controlID::invertFilterMod
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::invertFilterMod, auxAttribute);
-
-	// --- controlID::coupleQ
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::coupleQ, auxAttribute);
-
-	// --- controlID::enableDouble
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableDouble, auxAttribute);
-
-	// --- controlID::splitterBoost
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(2147483648);
-	setParamAuxAttribute(controlID::splitterBoost, auxAttribute);
-
-	// --- controlID::signalFlow
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(268435456);
-	setParamAuxAttribute(controlID::signalFlow, auxAttribute);
-
-	// --- controlID::m_uMySwitchVariable
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(805306368);
-	setParamAuxAttribute(controlID::m_uMySwitchVariable, auxAttribute);
-
-	// --- controlID::enableQMod
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableQMod, auxAttribute);
-
-	// --- controlID::enableThreshMod
-	auxAttribute.reset(auxGUIIdentifier::guiControlData);
-	auxAttribute.setUintAttribute(1073741824);
-	setParamAuxAttribute(controlID::enableThreshMod, auxAttribute);
+	// **--0xEDA5--**
 
+	// --- the plugin's controls; kept outside the RackAFX hex codes above (RackAFX regenerates that region), as the
+	//     meter IDs are kept outside the controlID enum
+	// --- RackAFX WORKFLOW: Quadra.prj still lists every control, so letting RackAFX regenerate this file refills the
+	//     region above with its own addPluginParameter( ) calls for the same controlIDs. After a regeneration (e.g. to
+	//     add a control in the RackAFX designer), move the new control into this table and empty the region again;
+	//     a controlID declared twice is rejected by addPluginParameter( ) and trips the assert below in debug builds
+	// --- the parameter descriptions are built at compile time and shared by every instance (names, string lists and
+	//     GUI attributes are parsed once per module); each instance only allocates the value/smoother and binds its member
+	static constexpr PluginCoreParameter parameterTable[] = {
+		{ makeStringListParameterDescriptor(controlID::splitSelect, "Split Select", "Splitter,LPF,Low Band,High Band,HPF", "Splitter", 805306368u, true), nullptr, &PluginCore::splitSelect },
+		{ makeContinuousParameterDescriptor(controlID::splitLow, "Low_Split", "Hertz", controlVariableType::kDouble, 50.0, 2000.0, 400.0, taper::kVoltOctaveTaper, 2147483648u), &PluginCore::splitLow, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::splitHigh, "High Split", "Hertz", controlVariableType::kDouble, 5000.0, 20000.0, 10000.0, taper::kLinearTaper, 2147483648u), &PluginCore::splitHigh, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::midSplit, "Mid Split", "Hertz", controlVariableType::kDouble, 300.0, 12000.0, 1000.0, taper::kLinearTaper, 2147483648u), &PluginCore::midSplit, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::lpfVolume, "LPF Volume", "dB", controlVariableType::kDouble, -60.0, 6.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::lpfVolume, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::lowbandVolume, "Low Band Volume", "dB", controlVariableType::kDouble, -60.0, 6.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::lowbandVolume, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::highbandVolume, "High Band Volume", "dB", controlVariableType::kDouble, -60.0, 6.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::highbandVolume, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::hpfVolume, "HPF Volume", "dB", controlVariableType::kDouble, -60.0, 6.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::hpfVolume, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::lpfSaturation, "LPF Saturation", "Units", controlVariableType::kDouble, 1.0, 10.0, 1.0, taper::kLinearTaper, 2147483648u), &PluginCore::lpfSaturation, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::lowbandSaturation, "Low Band Saturation", "Units", controlVariableType::kDouble, 1.0, 10.0, 1.0, taper::kLinearTaper, 2147483648u), &PluginCore::lowbandSaturation, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::highbandSaturation, "High Band Saturation", "Units", controlVariableType::kDouble, 1.0, 10.0, 1.0, taper::kLinearTaper, 2147483648u), &PluginCore::highbandSaturation, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::hpfSaturation, "HPF Saturation", "Units", controlVariableType::kDouble, 1.0, 10.0, 1.0, taper::kLinearTaper, 2147483648u), &PluginCore::hpfSaturation, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::dryVolume, "Dry Volume", "dB", controlVariableType::kDouble, -15.0, 0.0, -15.0, taper::kLinearTaper, 2147483648u), &PluginCore::dryVolume, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::fcModFilter, "ModFilter Cutoff", "Hertz", controlVariableType::kDouble, 80.0, 5000.0, 800.0, taper::kLinearTaper, 2147483648u), &PluginCore::fcModFilter, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::qModFilter, "ModFilter Q", "Units", controlVariableType::kDouble, 0.5, 10.0, 2.0, taper::kLinearTaper, 2147483648u), &PluginCore::qModFilter, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::threshold_db, "Threshold", "dB", controlVariableType::kDouble, -30.0, 0.0, -15.0, taper::kLinearTaper, 2147483648u), &PluginCore::threshold_db, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::attack_ms, "Attack", "ms", controlVariableType::kDouble, 1.0, 10.0, 8.0, taper::kLinearTaper, 2147483648u), &PluginCore::attack_ms, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::release_ms, "Release", "ms", controlVariableType::kDouble, 20.0, 400.0, 80.0, taper::kLinearTaper, 2147483648u), &PluginCore::release_ms, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::sensitivity, "Sensitivity", "Units", controlVariableType::kDouble, 0.25, 5.0, 1.0, taper::kLinearTaper, 2147483648u), &PluginCore::sensitivity, nullptr },
+		{ makeStringListParameterDescriptor(controlID::enableSplit, "Enable Splitter", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableSplit },
+		{ makeStringListParameterDescriptor(controlID::enableModFilter, "Enable ModFilter", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableModFilter },
+		{ makeStringListParameterDescriptor(controlID::typeModFilter, "ModFilter Type", "LPF,Band,HPF", "LPF", 805306368u, true), nullptr, &PluginCore::typeModFilter },
+		{ makeContinuousParameterDescriptor(controlID::filterBoost, "Boost", "dB", controlVariableType::kDouble, -5.0, 10.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::filterBoost, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::dryFilter, "Dry Filter", "dB", controlVariableType::kDouble, -15.0, 0.0, -15.0, taper::kLinearTaper, 2147483648u), &PluginCore::dryFilter, nullptr },
+		{ makeStringListParameterDescriptor(controlID::enableLFO, "Enable LFO", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableLFO },
+		{ makeContinuousParameterDescriptor(controlID::lfoRate, "LFO Rate", "Hz", controlVariableType::kDouble, 2.0, 15.0, 8.0, taper::kLinearTaper, 2147483648u), &PluginCore::lfoRate, nullptr },
+		{ makeContinuousParameterDescriptor(controlID::lfoDepth, "LFO Depth", "Units", controlVariableType::kDouble, 0.0, 100.0, 50.0, taper::kLinearTaper, 2147483648u), &PluginCore::lfoDepth, nullptr },
+		{ makeStringListParameterDescriptor(controlID::invertFilterMod, "Up/Down", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::invertFilterMod },
+		{ makeStringListParameterDescriptor(controlID::coupleQ, "Coupled Q", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::coupleQ },
+		{ makeStringListParameterDescriptor(controlID::enableDouble, "Enable Double", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableDouble },
+		{ makeContinuousParameterDescriptor(controlID::splitterBoost, "Splitter Boost", "dB", controlVariableType::kDouble, -5.0, 10.0, 0.0, taper::kLinearTaper, 2147483648u), &PluginCore::splitterBoost, nullptr },
+		{ makeStringListParameterDescriptor(controlID::signalFlow, "Signal Flow", "Splitter Filter,Filter Splitter,Parallel", "Splitter Filter", 268435456u, true), nullptr, &PluginCore::signalFlow },
+		{ makeStringListParameterDescriptor(controlID::m_uMySwitchVariable, "lfoDestination", "Fc,Q,Threshold", "Fc", 805306368u, true), nullptr, &PluginCore::m_uMySwitchVariable },
+		{ makeStringListParameterDescriptor(controlID::enableQMod, "SampleQ", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableQMod },
+		{ makeStringListParameterDescriptor(controlID::enableThreshMod, "SampleThreshold", "SWITCH OFF,SWITCH ON", "SWITCH OFF", 1073741824u, true), nullptr, &PluginCore::enableThreshMod }
+	};
+
+	for (const PluginCoreParameter& parameter : parameterTable)
+	{
+		PluginParameter* piParam = new PluginParameter(parameter.descriptor);
+		if (parameter.doubleVariable)
+			piParam->setBoundVariable(&(this->*parameter.doubleVariable), boundVariableType::kDouble);
+		else if (parameter.intVariable)
+			piParam->setBoundVariable(&(this->*parameter.intVariable), boundVariableType::kInt);
+
+		int32_t index = addPluginParameter(piParam);
+		assert(index >= 0 && "controlID declared twice: was the RackAFX parameter region regenerated?");
+		(void)index;
+	}
 
-	// **--0xEDA5--**
-   
     // --- BONUS Parameter
     // --- SCALE_GUI_SIZE
-    PluginParameter* piParamBonus = new PluginParameter(SCALE_GUI_SIZE, "Scale GUI", "tiny,small,medium,normal,large,giant", "normal");
+    static constexpr PluginParameterDescriptor scaleGUIDescriptor = makeStringListParameterDescriptor(SCALE_GUI_SIZE, "Scale GUI", "tiny,small,medium,normal,large,giant", "normal");
+    PluginParameter* piParamBonus = new PluginParameter(scaleGUIDescriptor);
     addPluginParameter(piParamBonus);
 
+	// --- band and ModFilter meters; the ballistics run on the audio side (BlockMeter), so the GUI detector is instant
+	static constexpr PluginParameterDescriptor bandMeterDescriptor[] = {
+		makeMeterParameterDescriptor(meterControlID::lpfPeakMeter, "LPF Peak", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::lowbandPeakMeter, "Low Band Peak", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::highbandPeakMeter, "High Band Peak", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::hpfPeakMeter, "HPF Peak", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::lpfRMSMeter, "LPF RMS", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::lowbandRMSMeter, "Low Band RMS", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::highbandRMSMeter, "High Band RMS", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter),
+		makeMeterParameterDescriptor(meterControlID::hpfRMSMeter, "HPF RMS", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK, meterCal::kLogMeter)
+	};
+	for (uint32_t i = 0; i < sizeof(bandMeterDescriptor) / sizeof(bandMeterDescriptor[0]); i++)
+	{
+		PluginParameter* piMeter = new PluginParameter(bandMeterDescriptor[i]);
+		float* meterVariable = i < FILTER_CURVE_NUM_BANDS ? &bandPeakMeter[i] : &bandRMSMeter[i - FILTER_CURVE_NUM_BANDS];
+		piMeter->setBoundVariable(meterVariable, boundVariableType::kFloat);
+		addPluginParameter(piMeter);
+	}
+
+	static constexpr PluginParameterDescriptor fcMeterDescriptor = makeMeterParameterDescriptor(meterControlID::modFilterFcMeter, "ModFilter fc", 0.0, 0.0, ENVELOPE_DETECT_MODE_PEAK);
+	PluginParameter* piFcMeter = new PluginParameter(fcMeterDescriptor);
+	piFcMeter->setBoundVariable(&modFilterFcMeter, boundVariableType::kFloat);
+	addPluginParameter(piFcMeter);
+
+#ifdef ENABLE_STAGE_PROFILING
+	// --- stage profiling meters: each stage's share of the buffer's real-time budget (1.0 = all of it)
+	static constexpr PluginParameterDescriptor profilerMeterDescriptor[] = {
+		makeMeterParameterDescriptor(profilerControlID::profileTotalLoad, "CPU Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK),
+		makeMeterParameterDescriptor(profilerControlID::profileParameterSyncLoad, "Param Sync Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK),
+		makeMeterParameterDescriptor(profilerControlID::profileSplitterLoad, "Splitter Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK),
+		makeMeterParameterDescriptor(profilerControlID::profileModFilterLoad, "ModFilter Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK),
+		makeMeterParameterDescriptor(profilerControlID::profileMixLoad, "Mix Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK),
+		makeMeterParameterDescriptor(profilerControlID::profileInputOutputLoad, "I/O Load", 0.0, 250.0, ENVELOPE_DETECT_MODE_PEAK)
+	};
+	float* profilerMeterVariable[] = { &profileTotalLoad, &profileParameterSyncLoad, &profileSplitterLoad,
+		&profileModFilterLoad, &profileMixLoad, &profileInputOutputLoad };
+	for (uint32_t i = 0; i < sizeof(profilerMeterDescriptor) / sizeof(profilerMeterDescriptor[0]); i++)
+	{
+		PluginParameter* piMeter = new PluginParameter(profilerMeterDescriptor[i]);
+		piMeter->setBoundVariable(profilerMeterVariable[i], boundVariableType::kFloat);
+		addPluginParameter(piMeter);
+	}
+#endif
+
 	// --- create the super fast access array
 	initPluginParameterArray();
 
@@ -514,6 +250,18 @@ bool PluginCore::reset(ResetInfo& resetInfo)
 
 	fourwaybandSplitter.reset(resetInfo.sampleRate);
 	modFilter.reset(resetInfo.sampleRate);
+	meterFrameCount = 0;
+
+	// --- frame processing cooks parameters every frame; its gain changes glide over MAX_PROCESS_BLOCK_FRAMES, the same
+	//     span its meters use (processAudioBlock( ) sets the actual block length instead)
+	fourwaybandSplitter.setGainRampLength(MAX_PROCESS_BLOCK_FRAMES);
+	modFilter.setGainRampLength(MAX_PROCESS_BLOCK_FRAMES);
+
+#ifdef ENABLE_STAGE_PROFILING
+	// --- one report per run of audio
+	logStageProfile();
+	stageProfiler.clearStatistics();
+#endif
 
     // --- other reset inits
     return PluginBase::reset(resetInfo);
@@ -529,6 +277,22 @@ bool PluginCore::initialize(PluginInfo& pluginInfo)
 {
 	// --- add one-time init stuff here
 
+#ifdef HAVE_FFTW
+	// --- FFTW wisdom lives next to the plugin and is shared by every instance; the first instance loads it
+	if (pluginInfo.pathToDLL)
+		FFTWPlanRegistry::getInstance().setWisdomFile((std::string(pluginInfo.pathToDLL) + ".fftw_wisdom").c_str());
+#endif
+
+#ifdef ENABLE_STAGE_PROFILING
+	// --- timeline tracing is off unless QUADRA_TRACE_FILE names a file prefix; one file per instance
+	const char* tracePrefix = getenv("QUADRA_TRACE_FILE");
+	if (tracePrefix && *tracePrefix)
+	{
+		std::string tracePath = std::string(tracePrefix) + "-" + std::to_string((unsigned long long)(uintptr_t)this) + ".json";
+		traceRecorder.start(tracePath.c_str(), getProfiledStageNames(), kNumProfiledStages);
+	}
+#endif
+
 	return true;
 }
 
@@ -548,20 +312,31 @@ Operation:
 */
 bool PluginCore::preProcessAudioBuffers(ProcessBufferInfo& processInfo)
 {
+#ifdef ENABLE_STAGE_PROFILING
+	stageProfiler.beginBuffer(processInfo.numFramesToProcess, audioProcDescriptor.sampleRate);
+#endif
+	PROFILE_STAGE_BEGIN(sync);
+
     // --- sync internal variables to GUI parameters; you can also do this manually if you don't
     //     want to use the auto-variable-binding
     syncInBoundVariables();
 
+	// --- the topology only changes here, between buffers
+	if (signalFlow != compiledSignalFlow)
+		buildProcessingGraph();
+
+	PROFILE_STAGE_END(stageProfiler, sync, kParameterSync, processInfo.numFramesToProcess);
     return true;
 }
 
 /**
-\brief frame-processing method
+\brief frame-processing method (used when kProcessBlocks is false)
 
 Operation:
 - decode the plugin type - for synth plugins, fill in the rendering code; for FX plugins, delete the if(synth) portion and add your processing code
 - note that MIDI events are fired for each sample interval so that MIDI is tightly sunk with audio
 - doSampleAccurateParameterUpdates will perform per-sample interval smoothing
+- the frame runs through the same compiled processing graph as processAudioBlock( ), as a one-frame block
 
 \param processFrameInfo structure of information about *frame* processing
 
@@ -569,103 +344,236 @@ Operation:
 */
 bool PluginCore::processAudioFrame(ProcessFrameInfo& processFrameInfo)
 {
-    // --- fire any MIDI events for this sample interval
-    processFrameInfo.midiEventQueue->fireMidiEvents(processFrameInfo.currentFrame);
+	// --- fire any MIDI events for this sample interval (the base class passes no queue when it is empty)
+	if (processFrameInfo.midiEventQueue)
+		processFrameInfo.midiEventQueue->fireMidiEvents(processFrameInfo.currentFrame);
 
 	// --- do per-frame updates; VST automation and parameter smoothing
 	doSampleAccurateParameterUpdates();
 
-    // --- decode the channelIOConfiguration and process accordingly
 	updateParameters();
 
-	bool splitterProcessed = false;
-	bool filterProcessed = false;
-	bool processed = false;
+	float* graphInput = processingGraph.getInputBuffer();
+	for (uint32_t i = 0; i < kGraphChannels; i++)
+		graphInput[i] = i < processFrameInfo.numAudioInChannels ? processFrameInfo.audioInputFrame[i] : 0.f;
+
+	const float* graphOutput = processingGraph.process(1, processFrameInfo.numAudioInChannels, processFrameInfo.numAudioOutChannels);
 
-	// --- check signal flow list
+	for (uint32_t i = 0; i < processFrameInfo.numAudioOutChannels && i < kGraphChannels; i++)
+		processFrameInfo.audioOutputFrame[i] = graphOutput[i];
 
-	// --- splitter to filter
-	if (compareIntToEnum(signalFlow, signalFlowEnum::Splitter_Filter))
+	// --- meters are still reduced in blocks: one update per MAX_PROCESS_BLOCK_FRAMES frames
+	if (++meterFrameCount >= MAX_PROCESS_BLOCK_FRAMES)
 	{
-		bool splitterProcessed = fourwaybandSplitter.processAudioFrame(
-			processFrameInfo.audioInputFrame,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
+		updateMeters(meterFrameCount, processFrameInfo.numAudioInChannels == 1 ? 1 : 2);
+		meterFrameCount = 0;
+	}
 
+	return true;
+}
 
-		float* splitterOutput = processFrameInfo.audioOutputFrame;
+/**
+\brief block-processing method (used when kProcessBlocks is true)
 
-		bool filterProcessed = modFilter.processAudioFrame(
-			splitterOutput,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
-	}
+Operation:
+- MIDI events are fired up front, before parameter cooking, so a handler's changes apply from the event's frame on
+  (the base class starts a block at every event offset and skips an empty queue)
+- parameter updates and cooking run once per block: the base class never lets a block span a reported automation
+  point, and drops to one-frame blocks for a buffer with a poll-only queue (so it is still polled once per sample);
+  smoothing (when enabled) steps once per block
+- the block is interleaved into the processing graph in one pass, the graph runs each stage over the whole block in turn,
+  and the result is deinterleaved in one pass
+- mono-in/stereo-out runs the graph mono and fans the result out to both outputs once per block
+- the meters are reduced from the splitter's taps once per block (updateMeters( ))
+- 64-bit host buffers run through processingGraph64, which stays in double from input to output
+
+\param processBlockInfo structure of information about *block* processing
 
-	// --- parallel
-	else if (compareIntToEnum(signalFlow, signalFlowEnum::Parallel))
-	{
-		float filterOutput[2]; 
-		float splitterOutput[2];
+\return true if operation succeeds, false otherwise
+*/
+bool PluginCore::processAudioBlock(ProcessBlockInfo& processBlockInfo)
+{
+	// --- fire any MIDI events for this block; blocks start at event offsets, so usually just the first frame, if any
+	for (uint32_t n = 0; n < processBlockInfo.numMidiFrames; n++)
+		processBlockInfo.midiEventQueue->fireMidiEvents(processBlockInfo.blockStartFrame + n);
+
+	PROFILE_STAGE_BEGIN(sync);
 
-		bool filterProcessed = modFilter.processAudioFrame(
-			processFrameInfo.audioInputFrame,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
+	// --- per-block updates; VST automation and parameter smoothing
+	doSampleAccurateParameterUpdates();
 
-		filterOutput[0] = processFrameInfo.audioOutputFrame[0];
-		filterOutput[1] = processFrameInfo.audioOutputFrame[1];
+	// --- gain changes glide over this block instead of stepping (no per-sample smoothing needed); blocks end at
+	//     sub-block boundaries, so every ramp reaches its target before the next automation point
+	fourwaybandSplitter.setGainRampLength(processBlockInfo.numFrames);
+	modFilter.setGainRampLength(processBlockInfo.numFrames);
 
-		bool splitterProcessed = fourwaybandSplitter.processAudioFrame(
-			processFrameInfo.audioInputFrame,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
+	updateParameters();
 
-		splitterOutput[0] = processFrameInfo.audioOutputFrame[0];
-		splitterOutput[1] = processFrameInfo.audioOutputFrame[1];
+	PROFILE_STAGE_END(stageProfiler, sync, kParameterSync, processBlockInfo.numFrames);
 
-		processFrameInfo.audioOutputFrame[0] = 0.5 * (filterOutput[0] + splitterOutput[0]);
-		processFrameInfo.audioOutputFrame[1] = 0.5 * (filterOutput[1] + splitterOutput[1]);
+	if (processBlockInfo.inputs64 && processBlockInfo.outputs64)
+		runProcessingGraph(processingGraph64, processBlockInfo.inputs64, processBlockInfo.outputs64, processBlockInfo);
+	else
+		runProcessingGraph(processingGraph, processBlockInfo.inputs, processBlockInfo.outputs, processBlockInfo);
 
+	updateMeters(processBlockInfo.numFrames, processBlockInfo.numAudioInChannels == 1 ? 1 : 2);
 
-	}
+	return true;
+}
+
+/**
+\brief reduce the block's metering taps and refresh the meter variables; postProcessAudioBuffers( ) sends them on
+
+Operation:
+- the splitter stored its band outputs during the block; here they are reduced once (SSE peak/sum of squares) and
+  the peak-hold release and RMS averaging advance by one block
+- the ModFilter fc is read once per block, after the envelope and LFO have moved it
 
-	// --- filter to splitter
-	else if (compareIntToEnum(signalFlow, signalFlowEnum::Filter_Splitter))
+\param numFrames frames in the block
+\param numChannels 1 if the block ran mono, otherwise 2
+*/
+void PluginCore::updateMeters(uint32_t numFrames, uint32_t numChannels)
+{
+	fourwaybandSplitter.updateMeters(numFrames, numChannels);
+	for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
 	{
-		bool filterProcessed = modFilter.processAudioFrame(
-			processFrameInfo.audioInputFrame,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
+		bandPeakMeter[b] = fourwaybandSplitter.getBandPeak(b);
+		bandRMSMeter[b] = fourwaybandSplitter.getBandRMS(b);
+	}
 
-		float* filterOutput = processFrameInfo.audioOutputFrame;
+	// --- 20Hz..20kHz is three decades
+	double fc = modFilter.getModulatedFc();
+	double fcPosition = fc > 20.0 ? log10(fc / 20.0) / 3.0 : 0.0;
+	modFilterFcMeter = (float)(fcPosition < 1.0 ? fcPosition : 1.0);
+}
 
+/**
+\brief send the FilterCurveView a coefficient snapshot if the curve changed during the buffer; called from
+postProcessAudioBuffers( )
 
-		bool splitterProcessed = fourwaybandSplitter.processAudioFrame(
-			filterOutput,
-			processFrameInfo.audioOutputFrame,
-			processFrameInfo.numAudioInChannels,
-			processFrameInfo.numAudioOutChannels);
+Operation:
+- does nothing unless the view is registered (the GUI is open); the GUI thread registers and clears filterCurveView
+  at any time, so it is loaded once and only that local copy is used
+- the snapshot is compared to the last one sent; parameter changes and ModFilter modulation republish, a steady
+  sound does not
+- the view keeps only the newest snapshot and evaluates it on the GUI thread
+*/
+void PluginCore::publishFilterCurve()
+{
+	ICustomView* view = filterCurveView.load(std::memory_order_acquire);
+	if (!view)
+		return;
+
+	FilterCurveSnapshot snapshot;
+	snapshot.sampleRate = audioProcDescriptor.sampleRate;
+	snapshot.signalFlow = (uint32_t)signalFlow;
+	fourwaybandSplitter.getFilterCurve(snapshot);
+	modFilter.getFilterCurve(snapshot);
+
+	if (snapshot == publishedFilterCurve && view == publishedFilterCurveView)
+		return;
+
+	view->sendMessage(&snapshot);
+	publishedFilterCurve = snapshot;
+	publishedFilterCurveView = view;
+}
 
-		float* splitterOutput = processFrameInfo.audioOutputFrame;
-		
-	}
+/**
+\brief run one block through a processing graph (float or 64-bit)
 
+Operation:
+- mono input: every stage only feeds its right output from the left, so the graph runs mono and the result is
+  fanned out to every output at the end
 
+\param graph processingGraph or processingGraph64
+\param inputs the host's input buffers, in the graph's sample format
+\param outputs the host's output buffers, in the graph's sample format
+\param processBlockInfo structure of information about *block* processing
+*/
+template <typename GraphType, typename SampleType>
+void PluginCore::runProcessingGraph(GraphType& graph, SampleType** inputs, SampleType** outputs, ProcessBlockInfo& processBlockInfo)
+{
+	bool monoGraph = processBlockInfo.numAudioInChannels == 1;
+	uint32_t graphOutChannels = monoGraph ? 1 : processBlockInfo.numAudioOutChannels;
+
+	PROFILE_STAGE_BEGIN(input);
+	graph.writeInputBlock(inputs, processBlockInfo.numAudioInChannels, processBlockInfo.blockStartFrame, processBlockInfo.numFrames);
+	PROFILE_STAGE_END(stageProfiler, input, kInputOutput, processBlockInfo.numFrames);
+
+	graph.process(processBlockInfo.numFrames, processBlockInfo.numAudioInChannels, graphOutChannels);
+
+	PROFILE_STAGE_BEGIN(output);
+	graph.readOutputBlock(outputs, processBlockInfo.numAudioOutChannels, processBlockInfo.blockStartFrame, processBlockInfo.numFrames, monoGraph);
+	PROFILE_STAGE_END(stageProfiler, output, kInputOutput, processBlockInfo.numFrames);
+}
 
-	// --- check if everything processed
-	if (splitterProcessed && filterProcessed)
+#ifdef ENABLE_STAGE_PROFILING
+
+/**
+\brief write the stage profile's min/avg/max to stderr; called on reset( ) and destruction, never on the audio thread
+*/
+void PluginCore::logStageProfile()
+{
+	char report[1024];
+	if (stageProfiler.getReport(report, sizeof(report)))
+		fputs(report, stderr);
+}
+#endif
+
+/**
+\brief describe a signal flow as a processing graph and compile it; only called when signalFlow changes (and by the
+constructor, to size graphArena)
+
+Operation:
+- Splitter_Filter: input -> splitter -> filter -> output
+- Filter_Splitter: input -> filter -> splitter -> output
+- Parallel: input -> filter and input -> splitter, averaged (0.5 each) into the output
+- new stages (per-band filters, a limiter...) are added here; they cost no per-sample branching; a topology that
+  needs more block buffers than any before it is sized for by the constructor's loop over every flow
+
+\param graph processingGraph or processingGraph64
+\param flow a signalFlowEnum value
+*/
+template <typename GraphType>
+void PluginCore::describeSignalFlow(GraphType& graph, int flow)
+{
+	graph.clear();
+	uint32_t splitter = graph.addStage(&fourwaybandSplitter);
+	uint32_t filter = graph.addStage(&modFilter);
+#ifdef ENABLE_STAGE_PROFILING
+	graph.setProfiledStage(splitter, kSplitter);
+	graph.setProfiledStage(filter, kModFilter);
+#endif
+
+	if (compareIntToEnum(flow, signalFlowEnum::Filter_Splitter))
 	{
-		FourWayBandSplitterParameters splitterParams = fourwaybandSplitter.getParameters();
-		ModFilterParameters filterParams = modFilter.getParameters();
-		processed = true;
+		graph.connect(kGraphInput, filter);
+		graph.connect(filter, splitter);
+		graph.connect(splitter, kGraphOutput);
 	}
+	else if (compareIntToEnum(flow, signalFlowEnum::Parallel))
+	{
+		graph.connect(kGraphInput, filter);
+		graph.connect(kGraphInput, splitter);
+		graph.connect(filter, kGraphOutput, 0.5f);
+		graph.connect(splitter, kGraphOutput, 0.5f);
+	}
+	else // --- Splitter_Filter
+	{
+		graph.connect(kGraphInput, splitter);
+		graph.connect(splitter, filter);
+		graph.connect(filter, kGraphOutput);
+	}
+
+	graph.compile();
+}
 
-	return processed;
+void PluginCore::buildProcessingGraph()
+{
+	// --- both graphs share the stages and graphArena; only the sample format differs
+	describeSignalFlow(processingGraph, signalFlow);
+	describeSignalFlow(processingGraph64, signalFlow);
+	compiledSignalFlow = signalFlow;
 }
 
 void PluginCore::updateParameters() 
@@ -737,6 +645,7 @@ void PluginCore::updateParameters()
 
 Operation:
 - updateOutBoundVariables sends metering data to the GUI meters
+- publishFilterCurve sends the FilterCurveView new coefficients when they changed
 
 \param processInfo structure of information about *buffer* processing
 
@@ -746,8 +655,21 @@ bool PluginCore::postProcessAudioBuffers(ProcessBufferInfo& processInfo)
 {
 	// --- update outbound variables; currently this is meter data only, but could be extended
 	//     in the future
+#ifdef ENABLE_STAGE_PROFILING
+	stageProfiler.endBuffer();
+	profileTotalLoad = stageProfiler.getTotalLoad();
+	profileParameterSyncLoad = stageProfiler.getStageLoad(kParameterSync);
+	profileSplitterLoad = stageProfiler.getStageLoad(kSplitter);
+	profileModFilterLoad = stageProfiler.getStageLoad(kModFilter);
+	profileMixLoad = stageProfiler.getStageLoad(kMix);
+	profileInputOutputLoad = stageProfiler.getStageLoad(kInputOutput);
+#endif
+
 	updateOutBoundVariables();
 
+	// --- filter curve for the GUI, if it changed
+	publishFilterCurve();
+
     return true;
 }
 
@@ -891,18 +813,37 @@ bool PluginCore::processMessage(MessageInfo& messageInfo)
 	// --- NULL pointers so that we don't accidentally use them
 	case PLUGINGUI_WILLCLOSE:
 	{
+		filterCurveView.store(nullptr, std::memory_order_release);
 		return false;
 	}
 
 	// --- update view; this will only be called if the GUI is actually open
 	case PLUGINGUI_TIMERPING:
 	{
+		ICustomView* view = filterCurveView.load(std::memory_order_acquire);
+		if (view)
+			view->updateView();
 		return false;
 	}
 
 	// --- register the custom view, grab the ICustomView interface
 	case PLUGINGUI_REGISTER_CUSTOMVIEW:
 	{
+		if (messageInfo.inMessageString.compare("CustomFilterCurveView") == 0)
+		{
+			filterCurveView.store(static_cast<ICustomView*>(messageInfo.inMessageData), std::memory_order_release);
+			return true;
+		}
+
+		return false;
+	}
+
+	case PLUGINGUI_DE_REGISTER_CUSTOMVIEW:
+	{
+		// --- only if it is still the registered view
+		ICustomView* view = static_cast<ICustomView*>(messageInfo.inMessageData);
+		if (view)
+			filterCurveView.compare_exchange_strong(view, nullptr, std::memory_order_acq_rel);
 
 		return false;
 	}
@@ -1036,6 +977,8 @@ bool PluginCore::initPluginDescriptors()
 
 	// --- describe the plugin attributes; set according to your needs
 	pluginDescriptor.hasSidechain = kWantSidechain;
+	pluginDescriptor.processBlocks = kProcessBlocks;
+	pluginDescriptor.processDoublePrecision = kProcessDoublePrecision;
 	pluginDescriptor.latencyInSamples = kLatencyInSamples;
 	pluginDescriptor.tailTimeInMSec = kTailTimeMsec;
 	pluginDescriptor.infiniteTailVST3 = kVSTInfiniteTail;
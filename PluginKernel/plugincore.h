@@ -16,6 +16,8 @@
 #include "pluginbase.h"
 #include "fourwaybandsplitter.h"
 #include "modfilter.h"
+#include "processinggraph.h"
+#include "stageprofiler.h"
 
 // **--0x7F1F--**
 
@@ -61,6 +63,29 @@ enum controlID {
 
 	// **--0x0F1F--**
 
+// --- outbound stage-profiling meters (ENABLE_STAGE_PROFILING only); kept outside the generated block above
+enum profilerControlID {
+	profileTotalLoad = 100,
+	profileParameterSyncLoad = 101,
+	profileSplitterLoad = 102,
+	profileModFilterLoad = 103,
+	profileMixLoad = 104,
+	profileInputOutputLoad = 105
+};
+
+// --- outbound band level and ModFilter cutoff meters; kept outside the generated block above
+enum meterControlID {
+	lpfPeakMeter = 110,
+	lowbandPeakMeter = 111,
+	highbandPeakMeter = 112,
+	hpfPeakMeter = 113,
+	lpfRMSMeter = 114,
+	lowbandRMSMeter = 115,
+	highbandRMSMeter = 116,
+	hpfRMSMeter = 117,
+	modFilterFcMeter = 118
+};
+
 /**
 \class PluginCore
 \ingroup ASPiK-Core
@@ -86,8 +111,13 @@ class PluginCore : public PluginBase
 public:
     PluginCore();
 
-	/** Destructor: empty in default version */
-    virtual ~PluginCore(){}
+	/** Destructor: logs the stage profile when ENABLE_STAGE_PROFILING is defined */
+    virtual ~PluginCore()
+	{
+#ifdef ENABLE_STAGE_PROFILING
+		logStageProfile();
+#endif
+	}
 
 	// --- PluginBase Overrides ---
 	//
@@ -106,6 +136,9 @@ public:
 	/** process frames of data */
 	virtual bool processAudioFrame(ProcessFrameInfo& processFrameInfo);
 
+	/** process blocks of data (kProcessBlocks in plugindescription.h) */
+	virtual bool processAudioBlock(ProcessBlockInfo& processBlockInfo);
+
 	// --- uncomment and override this for buffer processing; see base class implementation for
 	//     help on breaking up buffers and getting info from processBufferInfo
 	//virtual bool processAudioBuffers(ProcessBufferInfo& processBufferInfo);
@@ -139,11 +172,45 @@ public:
 
 	// --- BEGIN USER VARIABLES AND FUNCTIONS -------------------------------------- //
 	//	   Add your variables and methods here
+	DSPStateArenaStorage dspArena;	///< one cache-aligned arena for the hot state of both objects
 	FourWayBandSplitter fourwaybandSplitter;
 	ModFilter modFilter;
-	
+	GraphBlockArena graphArena;			///< block buffers of both graphs, sized once by the constructor
+	ProcessingGraph processingGraph;	///< compiled signal flow; rebuilt when signalFlow changes
+	ProcessingGraph64 processingGraph64;	///< the same signal flow over 64-bit host buffers
+	int compiledSignalFlow = -1;		///< signalFlow value processingGraph was built for
+
+	// --- FilterCurveView: coefficient snapshots, published at the end of a block only when they change
+	std::atomic<ICustomView*> filterCurveView{ nullptr };	///< registered "CustomFilterCurveView", or nullptr; written by the GUI thread, read by the audio thread
+	ICustomView* publishedFilterCurveView = nullptr;	///< view the last snapshot went to (audio thread only); a new view gets a fresh one
+	FilterCurveSnapshot publishedFilterCurve;		///< last snapshot sent
+
+	// --- outbound meters, updated once per block by updateMeters( )
+	float bandPeakMeter[FILTER_CURVE_NUM_BANDS] = { 0.f };	///< meters: band held peaks, linear (LPF, low, high, HPF)
+	float bandRMSMeter[FILTER_CURVE_NUM_BANDS] = { 0.f };	///< meters: band RMS levels, linear
+	float modFilterFcMeter = 0.f;		///< meter: modulated ModFilter fc, 20Hz - 20kHz mapped log to 0 - 1
+	uint32_t meterFrameCount = 0;		///< frames since the last updateMeters( ) (frame processing only)
+
+#ifdef ENABLE_STAGE_PROFILING
+	StageProfiler stageProfiler;		///< per-stage timing of each buffer
+	TraceRecorder traceRecorder;		///< timeline of the same spans; recording only if QUADRA_TRACE_FILE is set
+	float profileTotalLoad = 0.f;		///< meter: whole path, fraction of the real-time budget
+	float profileParameterSyncLoad = 0.f;	///< meter: parameter sync and cooking
+	float profileSplitterLoad = 0.f;	///< meter: band splitter
+	float profileModFilterLoad = 0.f;	///< meter: ModFilter (including its LFO)
+	float profileMixLoad = 0.f;			///< meter: graph mix steps
+	float profileInputOutputLoad = 0.f;	///< meter: host buffer <-> graph moves
+
+	void logStageProfile();
+#endif
 	
 	void updateParameters();
+	void publishFilterCurve();
+	void updateMeters(uint32_t numFrames, uint32_t numChannels);
+	void buildProcessingGraph();
+	template <typename GraphType> void describeSignalFlow(GraphType& graph, int flow);	///< a signal flow as stages and connections
+	template <typename GraphType, typename SampleType>
+	void runProcessingGraph(GraphType& graph, SampleType** inputs, SampleType** outputs, ProcessBlockInfo& processBlockInfo);
 
 	// --- END USER VARIABLES AND FUNCTIONS -------------------------------------- //
 
@@ -62,6 +62,8 @@ const int32_t kAAXProductID = '2255';
 
 // --- Plugin Options
 const bool kWantSidechain = false;
+const bool kProcessBlocks = true;
+const bool kProcessDoublePrecision = true;
 const uint32_t kLatencyInSamples = 0;
 const double kTailTimeMsec = 0.000;
 const bool kVSTInfiniteTail = false;
@@ -117,8 +117,9 @@ const bool ENABLE_CUSTOM_VIEWS = true;
 and the external void* for Windows.
 
 Operation: \n
-- creates UIDescription from the XML file; stores both the file and the description object (they get used or written later)
-- calls description->parse() to convert XML into objects
+- gets the UIDescription for the XML file from UIDescriptionCache; the XML is only parsed (description->parse()) for the
+  first editor, or when the file's content changed since it was cached
+- stores both the file and the description object (they get used or written later)
 - initializes main attributes
 - sets up the GUI timer for a 50 millisecond repaint interval
 */
@@ -143,14 +144,9 @@ PluginGUI::PluginGUI(UTF8StringPtr _xmlFile) :
     m_AU = nullptr;
 #endif
 
-	// --- create description from XML file
+	// --- get the description of the XML file; parsed once per process and content, then shared
 	xmlFile = _xmlFile;
-	description = new UIDescription(_xmlFile);
-	if (!description->parse())
-	{
-		description->forget();
-		description = nullptr;
-	}
+	description = UIDescriptionCache::getInstance().getDescription(_xmlFile, descriptionShared);
 
     // --- set attributes
     guiPluginConnector = nullptr;
@@ -166,6 +162,9 @@ PluginGUI::PluginGUI(UTF8StringPtr _xmlFile) :
 
     // --- create timer
     timer = new CVSTGUITimer(dynamic_cast<CBaseObject*>(this));
+
+	// --- share decoded bitmaps with the other editors while any are open
+	BitmapCache::getInstance().addEditor();
 }
 
 /**
@@ -174,6 +173,7 @@ PluginGUI::PluginGUI(UTF8StringPtr _xmlFile) :
 Operation: \n
 - destroys UIDescription
 - destroys timer
+- releases this editor's hold on the shared BitmapCache; the last editor also clears the UIDescriptionCache
 */
 PluginGUI::~PluginGUI()
 {
@@ -184,11 +184,36 @@ PluginGUI::~PluginGUI()
 	// --- kill timer
 	if (timer)
 		timer->forget();
+
+	// --- the last editor releases the shared bitmaps and parsed descriptions (its own reference is already gone)
+	if (BitmapCache::getInstance().removeEditor())
+		UIDescriptionCache::getInstance().clear();
 #if MAC
 	ReleaseVSTGUIBundleRef();
 #endif
 }
 
+/**
+\brief replaces a description shared through UIDescriptionCache with a private parse of the same file
+
+Operation:\n
+- used before the GUI Designer opens: its edits and saves then only touch this editor's copy; once saved,
+  the changed file no longer matches the cached hash and the next editor parses it again
+*/
+void PluginGUI::makeDescriptionPrivate()
+{
+	if (!description || !descriptionShared)
+		return;
+
+	UIDescription* privateDescription = UIDescriptionCache::parseDescription(xmlFile.c_str());
+	if (!privateDescription)
+		return;
+
+	description->forget();
+	description = privateDescription;
+	descriptionShared = false;
+}
+
 /**
 \brief creates the GUI control objects, creates outer frame, inserts contents into window
 
@@ -628,7 +653,8 @@ void PluginGUI::writeToPresetFile()
 
 Operation:\n
 - send the timer ping message
-- send process loop output data to any output-only receivers (meters)
+- send process loop output data to any output-only receivers (meters): only those the plugin's outbound
+  dirty set names, or, without a dirty set, those whose value moved by more than GUI_METER_CHANGE_THRESHOLD
 - issue the repaint message to the outer frame
 */
 void PluginGUI::idle()
@@ -639,18 +665,30 @@ void PluginGUI::idle()
         if(guiPluginConnector)
             guiPluginConnector->guiTimerPing();
 
-        for(std::vector<CControl*>::iterator it = writeableControls.begin(); it != writeableControls.end(); ++it)
+        // --- take the changed controlIDs once per tick; nothing marked means nothing to repaint
+        ControlDirtySet* dirtySet = guiPluginConnector ? guiPluginConnector->getOutboundDirtySet() : nullptr;
+        uint64_t dirtyWords[ControlDirtySet::kNumWords + 1];
+        bool pollAll = pollAllWriteableControls || !dirtySet;
+        bool anyDirty = dirtySet ? dirtySet->takeDirty(dirtyWords) : false;
+        pollAllWriteableControls = false;
+
+        if(guiPluginConnector && (pollAll || anyDirty))
         {
-            CControl* ctrl = *it;
-            if(ctrl)
+            for(std::vector<CControl*>::iterator it = writeableControls.begin(); it != writeableControls.end(); ++it)
             {
-                double param = 0.0;
-                if(guiPluginConnector)
-                {
-                    param = guiPluginConnector->getNormalizedPluginParameter(ctrl->getTag());
-                    ctrl->setValue((float)param);
-                    ctrl->invalid();
-                }
+                CControl* ctrl = *it;
+                if(!ctrl)
+                    continue;
+
+                if(!pollAll && !ControlDirtySet::isDirty(dirtyWords, (uint32_t)ctrl->getTag()))
+                    continue;
+
+                double param = guiPluginConnector->getNormalizedPluginParameter(ctrl->getTag());
+                if(fabs(param - ctrl->getValue()) <= GUI_METER_CHANGE_THRESHOLD)
+                    continue;
+
+                ctrl->setValue((float)param);
+                ctrl->invalid();
             }
         }
     }
@@ -880,6 +918,9 @@ bool PluginGUI::createGUI(bool bShowGUIEditor)
 #if VSTGUI_LIVE_EDITING
 		if (bShowGUIEditor)
 		{
+			// --- the designer edits the description; never let it edit the shared one
+			makeDescriptionPrivate();
+
 			guiEditorFrame->setTransform(CGraphicsTransform());
 			nonEditRect = guiEditorFrame->getViewSize();
 			description->setController((IController*)this);
@@ -1798,6 +1839,12 @@ CView* PluginGUI::createUserCustomView(std::string viewname, const CRect rect, I
 #endif
 	}
 
+	if (viewname.compare("CustomFilterCurveView") == 0)
+	{
+		// --- create our custom view
+		return new FilterCurveView(rect, listener, tag);
+	}
+
 	return nullptr;
 }
 
@@ -1914,9 +1961,7 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
         // --- bitmap
         std::string BMString = *bitmapString;
         BMString += ".png";
-        UTF8StringPtr bmp = BMString.c_str();
-        CResourceDescription bmpRes(bmp);
-        CBitmap* pBMP = new CBitmap(bmpRes);
+        CBitmap* pBMP = BitmapCache::getInstance().getBitmap(BMString);
         
         // --- offset
         CPoint offset(0.0, 0.0);
@@ -2023,9 +2068,7 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
         // --- bitmap
         std::string BMString = *bitmapString;
         BMString += ".png";
-        UTF8StringPtr bmp = BMString.c_str();
-        CResourceDescription bmpRes(bmp);
-        CBitmap* pBMP = new CBitmap(bmpRes);
+        CBitmap* pBMP = BitmapCache::getInstance().getBitmap(BMString);
         
         // --- offset
         CPoint offset(0.0, 0.0);
@@ -2143,9 +2186,7 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
         // --- bitmap
         std::string BMString = *bitmapString;
         BMString += ".png";
-        UTF8StringPtr bmp = BMString.c_str();
-        CResourceDescription bmpRes(bmp);
-        CBitmap* pBMP = new CBitmap(bmpRes);
+        CBitmap* pBMP = BitmapCache::getInstance().getBitmap(BMString);
         
         // --- offset
         // --- offset
@@ -2215,15 +2256,11 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
         // --- bitmap
         std::string BMString = *bitmapString;
         BMString += ".png";
-        UTF8StringPtr bmp = BMString.c_str();
-        CResourceDescription bmpRes(bmp);
-        CBitmap* pBMP_back = new CBitmap(bmpRes);
+        CBitmap* pBMP_back = BitmapCache::getInstance().getBitmap(BMString);
         
         std::string BMStringH = *handleBitmapString;
         BMStringH += ".png";
-        UTF8StringPtr bmpH = BMStringH.c_str();
-        CResourceDescription bmpResH(bmpH);
-        CBitmap* pBMP_hand = new CBitmap(bmpResH);
+        CBitmap* pBMP_hand = BitmapCache::getInstance().getBitmap(BMStringH);
         
         // --- offset
         CPoint offset(0.0, 0.0);
@@ -2293,15 +2330,11 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
         
         std::string onBMString = *ONbitmapString;
         onBMString += ".png";
-        UTF8StringPtr onbmp = onBMString.c_str();
-        CResourceDescription bmpRes(onbmp);
-        CBitmap* onBMP = new CBitmap(bmpRes);
+        CBitmap* onBMP = BitmapCache::getInstance().getBitmap(onBMString);
         
         std::string offBMString = *OFFbitmapString;
         offBMString += ".png";
-        UTF8StringPtr offbmp = offBMString.c_str();
-        CResourceDescription bmpRes2(offbmp);
-        CBitmap* offBMP = new CBitmap(bmpRes2);
+        CBitmap* offBMP = BitmapCache::getInstance().getBitmap(offBMString);
         
         int32_t nbLed = strtol(numLEDString->c_str(), 0, 10);
         
@@ -2369,15 +2402,11 @@ CView* PluginGUI::createView(const UIAttributes& attributes, const IUIDescriptio
             
             std::string onBMString = *ONbitmapString;
             onBMString += ".png";
-            UTF8StringPtr onbmp = onBMString.c_str();
-            CResourceDescription bmpRes(onbmp);
-            CBitmap* onBMP = new CBitmap(bmpRes);
+            CBitmap* onBMP = BitmapCache::getInstance().getBitmap(onBMString);
             
             std::string offBMString = *OFFbitmapString;
             offBMString += ".png";
-            UTF8StringPtr offbmp = offBMString.c_str();
-            CResourceDescription bmpRes2(offbmp);
-            CBitmap* offBMP = new CBitmap(bmpRes2);
+            CBitmap* offBMP = BitmapCache::getInstance().getBitmap(offBMString);
             
             int32_t nbLed = strtol(numLEDString->c_str(), 0, 10);
             
@@ -384,6 +384,234 @@ protected:
 };
 
 
+/**
+\class UIDescriptionCache
+\ingroup ASPiK-GUI
+\brief
+The UIDescriptionCache object parses each .uidesc file once per process and hands that parsed UIDescription to every
+PluginGUI that opens the same file, so every editor after the first skips the XML parse and shares one view/bitmap tree.
+
+- entries are keyed by file name and validated by a 64-bit FNV-1a hash of the file's bytes; hashing is a straight read,
+  far cheaper than the parse, and a file that changed on disk (e.g. saved from the GUI designer) is parsed again from XML
+- a file that cannot be read for hashing is parsed privately, exactly as before, and not cached
+- the cache keeps one reference to each description; callers get their own reference and forget( ) it as usual
+- GUI thread only, like the rest of VSTGUI; the last PluginGUI to close calls clear( ) (see BitmapCache::removeEditor( )),
+  so nothing stays resident while no editor is open and nothing is left for static destruction
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class UIDescriptionCache
+{
+public:
+	/** the process-wide cache */
+	static UIDescriptionCache& getInstance()
+	{
+		static UIDescriptionCache cache;
+		return cache;
+	}
+
+	/**
+	\brief get a parsed description for a .uidesc file, from the cache when the file's content hash still matches
+
+	\param xmlFile the .uidesc file
+	\param shared set to true if the description is the cached one, shared with other editors (do not edit it)
+	\return a description holding one reference for the caller, or nullptr if the file does not parse
+	*/
+	UIDescription* getDescription(UTF8StringPtr xmlFile, bool& shared)
+	{
+		shared = false;
+		uint64_t contentHash = 0;
+		if (!hashFile(xmlFile, contentHash))
+			return parseDescription(xmlFile);
+
+		std::map<std::string, CacheEntry>::iterator it = entries.find(xmlFile);
+		if (it != entries.end())
+		{
+			if (it->second.contentHash == contentHash)
+			{
+				it->second.description->remember();
+				shared = true;
+				return it->second.description;
+			}
+
+			// --- stale; editors still holding the old one keep it alive until they close
+			it->second.description->forget();
+			entries.erase(it);
+		}
+
+		UIDescription* description = parseDescription(xmlFile);
+		if (!description)
+			return nullptr;
+
+		CacheEntry entry;
+		entry.contentHash = contentHash;
+		entry.description = description;
+		entries[xmlFile] = entry;
+
+		description->remember();
+		shared = true;
+		return description;
+	}
+
+	/** release every cached description */
+	void clear()
+	{
+		for (std::map<std::string, CacheEntry>::iterator it = entries.begin(); it != entries.end(); ++it)
+			it->second.description->forget();
+		entries.clear();
+	}
+
+	/** parse a description from XML; nullptr if it does not parse */
+	static UIDescription* parseDescription(UTF8StringPtr xmlFile)
+	{
+		UIDescription* description = new UIDescription(xmlFile);
+		if (!description->parse())
+		{
+			description->forget();
+			return nullptr;
+		}
+		return description;
+	}
+
+protected:
+	/** FNV-1a over the file's bytes, opened the way UIDescription opens it: as a file, else as a resource */
+	static bool hashFile(UTF8StringPtr xmlFile, uint64_t& contentHash)
+	{
+		if (!xmlFile)
+			return false;
+
+		CFileStream fileStream;
+		if (fileStream.open(xmlFile, CFileStream::kReadMode))
+			return hashStream(fileStream, contentHash);
+
+		CResourceInputStream resourceStream;
+		if (resourceStream.open(CResourceDescription(xmlFile)))
+			return hashStream(resourceStream, contentHash);
+
+		return false;
+	}
+
+	static bool hashStream(InputStream& stream, uint64_t& contentHash)
+	{
+		uint8_t chunk[16384];
+		uint64_t hash = 14695981039346656037ull;
+		uint64_t length = 0;
+		for (;;)
+		{
+			uint32_t numRead = stream.readRaw(chunk, sizeof(chunk));
+			if (numRead == 0 || numRead == kStreamIOError)
+				break;
+			for (uint32_t i = 0; i < numRead; i++)
+				hash = (hash ^ chunk[i]) * 1099511628211ull;
+			length += numRead;
+		}
+		contentHash = hash;
+		return length > 0;
+	}
+
+	struct CacheEntry
+	{
+		uint64_t contentHash = 0;				///< FNV-1a of the file when it was parsed
+		UIDescription* description = nullptr;	///< the parsed file; the cache holds one reference
+	};
+	std::map<std::string, CacheEntry> entries;	///< file name -> parsed description
+
+	UIDescriptionCache() {}
+	~UIDescriptionCache() {}	// --- entries are released by clear( ) when the last editor closes, not at static destruction when VSTGUI may be gone
+};
+
+
+/**
+\class BitmapCache
+\ingroup ASPiK-GUI
+\brief
+The BitmapCache object shares decoded filmstrips and backgrounds (knobs, buttons, sliders, meters) between every open
+editor in the process, so 30 editors hold one decoded copy of each image instead of 30.
+
+- bitmaps are keyed by resource name and decoded by the first getBitmap( ) for that name; that call comes from
+  createView( ), so the first editor to open decodes every code-created image while it builds its view hierarchy,
+  whether or not the view is visible yet, and later editors reuse the decoded copy
+- bitmaps load at their 1x resource, exactly as the direct new CBitmap( ) calls did; the GUI zoom (scaleGUISize( ))
+  is a frame transform and does not select a different image
+- callers get a reference, exactly like new CBitmap( ): they hand it to the view and forget( ) their own
+- PluginGUI counts open editors with addEditor( )/removeEditor( ); when the last one goes, the cache lets go of every
+  bitmap, so nothing stays resident while no editor is open
+- GUI thread only, like the rest of VSTGUI
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class BitmapCache
+{
+public:
+	/** the process-wide cache */
+	static BitmapCache& getInstance()
+	{
+		static BitmapCache cache;
+		return cache;
+	}
+
+	/**
+	\brief get a decoded bitmap, decoding it the first time the name is asked for
+
+	\param resource the image resource, e.g. "knobs/knob1.png"
+	\return the bitmap with one reference for the caller
+	*/
+	CBitmap* getBitmap(const std::string& resource)
+	{
+		std::map<std::string, CBitmap*>::iterator it = bitmaps.find(resource);
+		if (it != bitmaps.end())
+		{
+			it->second->remember();
+			return it->second;
+		}
+
+		CBitmap* bitmap = new CBitmap(CResourceDescription(resource.c_str()));
+		if (!bitmap->getPlatformBitmap())
+			return bitmap; // --- missing image: same behavior as before, but not cached
+
+		// --- one reference for the cache, one for the caller
+		bitmaps[resource] = bitmap;
+		bitmap->remember();
+		return bitmap;
+	}
+
+	/** an editor opened */
+	void addEditor() { numEditors++; }
+
+	/** an editor closed; the last one releases every bitmap */
+	/**
+	\return true if that was the last open editor
+	*/
+	bool removeEditor()
+	{
+		if (numEditors == 0 || --numEditors > 0)
+			return false;
+
+		clear();
+		return true;
+	}
+
+	/** release every bitmap (views still using one keep it alive until they go) */
+	void clear()
+	{
+		for (std::map<std::string, CBitmap*>::iterator it = bitmaps.begin(); it != bitmaps.end(); ++it)
+			it->second->forget();
+		bitmaps.clear();
+	}
+
+protected:
+	std::map<std::string, CBitmap*> bitmaps;	///< resource name -> decoded bitmap; the cache holds one reference
+	uint32_t numEditors = 0;					///< open PluginGUIs
+
+	BitmapCache() {}
+	~BitmapCache() {}	// --- released by the last removeEditor( ), not at static destruction when VSTGUI may be gone
+};
+
+
 /**
 \class PluginGUI
 \ingroup ASPiK-GUI
@@ -459,6 +687,9 @@ protected:
 	/** create the GUI, or the GUI Designer if user is launching it */
 	bool createGUI(bool bShowGUIEditor);
 
+	/** swap a shared (cached) description for a private parse, so the GUI Designer never edits other editors' copy */
+	void makeDescriptionPrivate();
+
 	/** save the current state in XML */
 	void save(bool saveAs = false);
 
@@ -494,6 +725,7 @@ protected:
 	// --- protected variables
     IGUIPluginConnector* guiPluginConnector = nullptr; ///< the plugin shell interface that arrives with the open( ) function; OK if NULL for standalone GUIs
 	UIDescription* description = nullptr; ///< the description version of the XML file
+	bool descriptionShared = false;	///< description came from UIDescriptionCache and is shared with other editors
 	std::string viewName;			///< name
 	std::string xmlFile;			///< the XML file name
 
@@ -752,6 +984,7 @@ public:
         {
             writeableControls.push_back(control);
             control->remember();
+            pollAllWriteableControls = true;
         }
     }
 
@@ -836,6 +1069,7 @@ private:
     typedef std::map<int32_t, ControlUpdateReceiver*> ControlUpdateReceiverMap; ///< map of control receivers
     ControlUpdateReceiverMap controlUpdateReceivers;
     std::vector<CControl*> writeableControls;		///< vector of meters
+    bool pollAllWriteableControls = true;			///< next idle( ) reads every meter, not just the dirty ones (new controls)
     std::vector<PluginParameter*> pluginParameters; ///< local COPY of parameters
 
 #ifdef AAXPLUGIN
@@ -11,6 +11,42 @@
 */
 // -----------------------------------------------------------------------------
 #include "pluginparameter.h"
+#include <mutex>
+
+/**
+\brief split a comma-separated list into strings (helper)
+
+\param commaSeparatedList simple character string of comma-separated items
+\param stringList the list to append to
+*/
+static void parseCommaSeparatedList(const char* commaSeparatedList, std::vector<std::string>& stringList)
+{
+    std::stringstream ss(commaSeparatedList);
+    while(ss.good())
+    {
+        std::string substr;
+        getline(ss, substr, ',');
+        stringList.push_back(substr);
+    }
+}
+
+/**
+\brief join a string list back into a comma-separated list (helper)
+
+\param stringList the strings
+\return the comma-separated list
+*/
+static std::string joinStringList(const std::vector<std::string>& stringList)
+{
+    std::string commaSeparatedStringList;
+    for(std::vector<std::string>::const_iterator it = stringList.begin(); it != stringList.end(); ++it)
+    {
+        if(commaSeparatedStringList.size() > 0)
+            commaSeparatedStringList.append(",");
+        commaSeparatedStringList.append(*it);
+    }
+    return commaSeparatedStringList;
+}
 
 /**
 \brief constructor for most knobs and sliders
@@ -29,15 +65,16 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, const
                                  controlVariableType _controlType, double _minValue, double _maxValue, double _defaultValue,
                                  taper _controlTaper, uint32_t _displayPrecision)
 : controlID(_controlID)
-, controlName(_controlName)
-, controlUnits(_controlUnits)
 , controlType(_controlType)
 , minValue(_minValue)
 , maxValue(_maxValue)
 , defaultValue(_defaultValue)
 , controlTaper(_controlTaper)
 , displayPrecision(_displayPrecision)
+, metadata(std::make_shared<PluginParameterMetadata>())
 {
+    metadata->controlName.assign(_controlName);
+    metadata->controlUnits.assign(_controlUnits);
     setControlValue(_defaultValue);
     setSmoothedTargetValue(_defaultValue);
     useParameterSmoothing = false;
@@ -54,13 +91,14 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, const
 */
 PluginParameter::PluginParameter(int _controlID, const char* _controlName, std::vector<std::string> _stringList, std::string _defaultString)
 : controlID(_controlID)
-, controlName(_controlName)
-, stringList(_stringList)
+, metadata(std::make_shared<PluginParameterMetadata>())
 {
+    metadata->controlName.assign(_controlName);
+    metadata->stringList = _stringList;
     setControlValue(0.0);
     setSmoothedTargetValue(0.0);
     setControlVariableType(controlVariableType::kTypedEnumStringList);
-    setMaxValue((double)stringList.size()-1);
+    setMaxValue((double)getStringCount()-1);
 
     int defaultStringIndex = findStringIndex(_defaultString);
     if(defaultStringIndex >= 0)
@@ -83,24 +121,19 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, std::
 */
 PluginParameter::PluginParameter(int _controlID, const char* _controlName, const char* _commaSeparatedList, std::string _defaultString)
 : controlID(_controlID)
-, controlName(_controlName)
+, metadata(std::make_shared<PluginParameterMetadata>())
 {
+    metadata->controlName.assign(_controlName);
     setControlValue(0.0);
     setSmoothedTargetValue(0.0);
 
-    std::stringstream ss(_commaSeparatedList);
-    while(ss.good())
-    {
-        std::string substr;
-        getline(ss, substr, ',');
-        stringList.push_back(substr);
-    }
+    parseCommaSeparatedList(_commaSeparatedList, metadata->stringList);
 
 	// --- create csvlist
 	setCommaSeparatedStringList();
 
     setControlVariableType(controlVariableType::kTypedEnumStringList);
-    setMaxValue((double)stringList.size()-1);
+    setMaxValue((double)getStringCount()-1);
 
     int defaultStringIndex = findStringIndex(_defaultString);
     if(defaultStringIndex >= 0)
@@ -126,11 +159,13 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, const
 */
 PluginParameter::PluginParameter(int _controlID, const char* _controlName, double _meterAttack_ms, double _meterRelease_ms, uint32_t _detectorMode, meterCal _meterCal)
 : controlID(_controlID)
-, controlName(_controlName)
+, metadata(std::make_shared<PluginParameterMetadata>())
 , meterAttack_ms(_meterAttack_ms)
 , meterRelease_ms(_meterRelease_ms)
 , detectorMode(_detectorMode)
 {
+	metadata->controlName.assign(_controlName);
+
 	if (_meterCal == meterCal::kLinearMeter)
 		setLogMeter(false);
 	else
@@ -153,9 +188,10 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, doubl
 */
 PluginParameter::PluginParameter(int _controlID, const char* _controlName, controlVariableType _controlType)
 : controlID(_controlID)
-, controlName(_controlName)
 , controlType(_controlType)
+, metadata(std::make_shared<PluginParameterMetadata>())
 {
+    metadata->controlName.assign(_controlName);
     setControlValue(0.0);
     setSmoothedTargetValue(0.0);
 
@@ -167,6 +203,7 @@ PluginParameter::PluginParameter(int _controlID, const char* _controlName, contr
 \brief simple constructor - you can always use this and then use the massive number of get/set functions to customize in any manner
 */
 PluginParameter::PluginParameter()
+: metadata(std::make_shared<PluginParameterMetadata>())
 {
     setControlValue(0.0);
     setSmoothedTargetValue(0.0);
@@ -175,6 +212,81 @@ PluginParameter::PluginParameter()
     setIsWritable(false);
 }
 
+/**
+\brief construct any type of parameter from a static descriptor; the name, units, string list and aux attributes
+are shared with every other parameter made from the same descriptor, so only the value and smoother are per-instance
+
+\param descriptor the parameter description; must have static storage duration (e.g. a constexpr table entry)
+*/
+PluginParameter::PluginParameter(const PluginParameterDescriptor& descriptor)
+: controlID(descriptor.controlID)
+, controlType(descriptor.controlType)
+, minValue(descriptor.minValue)
+, maxValue(descriptor.maxValue)
+, defaultValue(descriptor.defaultValue)
+, controlTaper(descriptor.controlTaper)
+, displayPrecision(descriptor.displayPrecision)
+, metadata(getSharedMetadata(descriptor))
+, isWritable(descriptor.controlType == controlVariableType::kMeter)
+, isDiscreteSwitch(descriptor.isDiscreteSwitch)
+, meterAttack_ms(descriptor.meterAttack_ms)
+, meterRelease_ms(descriptor.meterRelease_ms)
+, detectorMode(descriptor.detectorMode)
+, logMeter(descriptor.meterCalibration == meterCal::kLogMeter)
+, useParameterSmoothing(descriptor.useParameterSmoothing)
+, smoothingTimeMsec(descriptor.smoothingTimeMsec)
+{
+    // --- string-lists take their range and default from the strings
+    if(controlType == controlVariableType::kTypedEnumStringList)
+    {
+        maxValue = (double)getStringCount() - 1;
+        int defaultStringIndex = descriptor.defaultString ? findStringIndex(descriptor.defaultString) : -1;
+        defaultValue = defaultStringIndex >= 0 ? (double)defaultStringIndex : 0.0;
+    }
+
+    // --- straight to the atomic; there is nothing to smooth from yet
+    setControlValue(defaultValue, true);
+    setSmoothedTargetValue(defaultValue);
+}
+
+/**
+\brief get the module-wide metadata for a descriptor; the first parameter made from it parses it, the rest share it
+
+\param descriptor the parameter description, keyed by address
+
+\return the shared metadata
+*/
+std::shared_ptr<PluginParameterMetadata> PluginParameter::getSharedMetadata(const PluginParameterDescriptor& descriptor)
+{
+	// --- instances may be constructed on several host threads at once
+	static std::mutex registryMutex;
+	static std::map<const PluginParameterDescriptor*, std::shared_ptr<PluginParameterMetadata>> registry;
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	std::shared_ptr<PluginParameterMetadata>& shared = registry[&descriptor];
+	if (shared)
+		return shared;
+
+	shared = std::make_shared<PluginParameterMetadata>();
+	if (descriptor.controlName)
+		shared->controlName.assign(descriptor.controlName);
+	if (descriptor.controlUnits)
+		shared->controlUnits.assign(descriptor.controlUnits);
+	if (descriptor.commaSeparatedList)
+	{
+		parseCommaSeparatedList(descriptor.commaSeparatedList, shared->stringList);
+		shared->commaSeparatedStringList = joinStringList(shared->stringList);
+	}
+	if (descriptor.guiControlData)
+	{
+		AuxParameterAttribute auxAttribute;
+		auxAttribute.reset(auxGUIIdentifier::guiControlData);
+		auxAttribute.setUintAttribute(descriptor.guiControlData);
+		shared->auxAttributes.insert(std::make_pair(auxAttribute.attributeID, auxAttribute));
+	}
+	return shared;
+}
+
 
 /**
 \brief copy constructor
@@ -182,9 +294,7 @@ PluginParameter::PluginParameter()
 PluginParameter::PluginParameter(const PluginParameter& initGuiControl)
 {
     controlID = initGuiControl.controlID;
-    controlName = initGuiControl.controlName;
-	controlUnits = initGuiControl.controlUnits;
-	commaSeparatedStringList = initGuiControl.commaSeparatedStringList;
+	metadata = initGuiControl.metadata;
 	controlType = initGuiControl.controlType;
     minValue = initGuiControl.minValue;
     maxValue = initGuiControl.maxValue;
@@ -192,7 +302,6 @@ PluginParameter::PluginParameter(const PluginParameter& initGuiControl)
     controlValueAtomic = initGuiControl.getAtomicControlValueFloat();
     controlTaper = initGuiControl.controlTaper;
     displayPrecision = initGuiControl.displayPrecision;
-    stringList = initGuiControl.stringList;
     useParameterSmoothing = initGuiControl.useParameterSmoothing;
     smoothingType = initGuiControl.smoothingType;
     smoothingTimeMsec = initGuiControl.smoothingTimeMsec;
@@ -206,17 +315,10 @@ PluginParameter::PluginParameter(const PluginParameter& initGuiControl)
 }
 
 /**
-\brief only need to clean out the aux parameters - everything else is self deleting
+\brief nothing to clean out - the aux parameters live in the reference-counted metadata
 */
 PluginParameter::~PluginParameter()
 {
-	// --- clear aux attributes
-	for (auxParameterAttributeMap::const_iterator it = auxAttributeMap.begin(), end = auxAttributeMap.end(); it != end; ++it)
-	{
-		delete it->second;
-	}
-
-	auxAttributeMap.clear();
 }
 
 /**
@@ -229,10 +331,10 @@ std::string PluginParameter::getControlValueAsString()
 	std::string empty;
 	if (controlType == controlVariableType::kTypedEnumStringList)
 	{
-		if ((uint32_t)getAtomicControlValueFloat() >= stringList.size())
+		if ((uint32_t)getAtomicControlValueFloat() >= getStringCount())
 			return empty;
 
-		return stringList[(uint32_t)getAtomicControlValueFloat()];
+		return metadata->stringList[(uint32_t)getAtomicControlValueFloat()];
 	}
 
 	std::ostringstream ss;
@@ -266,7 +368,7 @@ std::string PluginParameter::getControlValueAsString()
 	if (appendUnits)
 	{
 		formattedString += " ";
-		formattedString += controlUnits;
+		formattedString += metadata->controlUnits;
 	}
 
 	return formattedString;
@@ -281,10 +383,10 @@ std::string PluginParameter::getControlValueAsString()
 std::string PluginParameter::getStringByIndex(uint32_t index)
 {
 	std::string empty;
-	if (index >= stringList.size())
+	if (index >= getStringCount())
 		return empty;
 
-	return stringList[index];
+	return metadata->stringList[index];
 }
 
 /**
@@ -292,15 +394,8 @@ std::string PluginParameter::getStringByIndex(uint32_t index)
 */
 void PluginParameter::setCommaSeparatedStringList()
 {
-    commaSeparatedStringList.clear();
-
-    for(std::vector<std::string>::iterator it = stringList.begin(); it != stringList.end(); ++it)
-    {
-        std::string subStr = *it;
-        if(commaSeparatedStringList.size() > 0)
-            commaSeparatedStringList.append(",");
-        commaSeparatedStringList.append(subStr);
-    }
+    PluginParameterMetadata& editableMetadata = editMetadata();
+    editableMetadata.commaSeparatedStringList = joinStringList(editableMetadata.stringList);
 }
 
 /**
@@ -313,12 +408,10 @@ void PluginParameter::setCommaSeparatedStringList()
 */
 uint32_t PluginParameter::setAuxAttribute(uint32_t attributeID, const AuxParameterAttribute& auxParameterAtribute)
 {
-	AuxParameterAttribute* newAttribute = new AuxParameterAttribute(auxParameterAtribute);
-	if (!newAttribute) return 0;
-
-	auxAttributeMap.insert(std::make_pair(attributeID, newAttribute));
+	PluginParameterMetadata& editableMetadata = editMetadata();
+	editableMetadata.auxAttributes.insert(std::make_pair(attributeID, auxParameterAtribute));
 
-	return (uint32_t)auxAttributeMap.size();
+	return (uint32_t)editableMetadata.auxAttributes.size();
 }
 
 /**
@@ -326,13 +419,15 @@ uint32_t PluginParameter::setAuxAttribute(uint32_t attributeID, const AuxParamet
 
 \param attributeID unique identifier of attribute
 
-\return a naked pointer to the attribute
+\return a read-only pointer to the attribute; the metadata may be shared with every other instance, so changes go through
+setAuxAttribute( ), which copies shared metadata first
 */
-AuxParameterAttribute* PluginParameter::getAuxAttribute(uint32_t attributeID)
+const AuxParameterAttribute* PluginParameter::getAuxAttribute(uint32_t attributeID)
 {
-	if (auxAttributeMap.find(attributeID) == auxAttributeMap.end()) {
+	std::map<uint32_t, AuxParameterAttribute>::const_iterator it = metadata->auxAttributes.find(attributeID);
+	if (it == metadata->auxAttributes.end()) {
 		return nullptr;
 	}
 
-	return  auxAttributeMap[attributeID];
+	return &it->second;
 }
@@ -20,11 +20,100 @@
 #include <map>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 
 #include <math.h>
 #include "pluginstructures.h"
 #include "guiconstants.h"
 
+/**
+\struct PluginParameterDescriptor
+\ingroup Structures
+\brief
+Everything about a parameter that never changes, as a literal type: a plugin declares its parameters as one constexpr
+table of these (see the make...ParameterDescriptor( ) helpers) and every instance builds its PluginParameters from the
+same table with PluginParameter(const PluginParameterDescriptor&).
+
+- the descriptor must have static storage duration; its address keys the shared PluginParameterMetadata
+- string fields are not copied per instance; nullptr leaves the PluginParameter default
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct PluginParameterDescriptor
+{
+	int controlID;						///< the ID value for the parameter
+	const char* controlName;			///< the name string
+	const char* controlUnits;			///< the units string; nullptr = "Units"
+	controlVariableType controlType;	///< the control type
+	double minValue;					///< min (continuous controls)
+	double maxValue;					///< max (continuous controls)
+	double defaultValue;				///< default (continuous controls)
+	taper controlTaper;					///< the taper
+	uint32_t displayPrecision;			///< sig digits for display
+	const char* commaSeparatedList;		///< the strings of a string-list control; nullptr otherwise
+	const char* defaultString;			///< default string of a string-list control
+	bool isDiscreteSwitch;				///< switch flag
+	bool useParameterSmoothing;			///< enable param smoothing
+	double smoothingTimeMsec;			///< param smoothing time
+	double meterAttack_ms;				///< meter attack time in milliseconds
+	double meterRelease_ms;				///< meter release time in milliseconds
+	uint32_t detectorMode;				///< meter detector mode
+	meterCal meterCalibration;			///< meter is linear or log
+	uint32_t guiControlData;			///< auxGUIIdentifier::guiControlData aux attribute; 0 = none
+};
+
+/** describe a continuous control; mirrors the continuous PluginParameter constructor */
+constexpr PluginParameterDescriptor makeContinuousParameterDescriptor(int controlID, const char* controlName, const char* controlUnits,
+	controlVariableType controlType, double minValue, double maxValue, double defaultValue, taper controlTaper = taper::kLinearTaper,
+	uint32_t guiControlData = 0, bool useParameterSmoothing = false, double smoothingTimeMsec = 100.0, uint32_t displayPrecision = 2)
+{
+	return { controlID, controlName, controlUnits, controlType, minValue, maxValue, defaultValue, controlTaper, displayPrecision,
+		nullptr, nullptr, false, useParameterSmoothing, smoothingTimeMsec, 10.0, 500.0, ENVELOPE_DETECT_MODE_RMS, meterCal::kLinearMeter,
+		guiControlData };
+}
+
+/** describe a string-list control; mirrors the comma-separated-list PluginParameter constructor */
+constexpr PluginParameterDescriptor makeStringListParameterDescriptor(int controlID, const char* controlName, const char* commaSeparatedList,
+	const char* defaultString, uint32_t guiControlData = 0, bool isDiscreteSwitch = false)
+{
+	return { controlID, controlName, nullptr, controlVariableType::kTypedEnumStringList, 0.0, 1.0, 0.0, taper::kLinearTaper, 2,
+		commaSeparatedList, defaultString, isDiscreteSwitch, false, 100.0, 10.0, 500.0, ENVELOPE_DETECT_MODE_RMS, meterCal::kLinearMeter,
+		guiControlData };
+}
+
+/** describe a meter; mirrors the meter PluginParameter constructor */
+constexpr PluginParameterDescriptor makeMeterParameterDescriptor(int controlID, const char* controlName, double meterAttack_ms,
+	double meterRelease_ms, uint32_t detectorMode, meterCal meterCalibration = meterCal::kLinearMeter)
+{
+	return { controlID, controlName, nullptr, controlVariableType::kMeter, 0.0, 1.0, 0.0, taper::kLinearTaper, 2,
+		nullptr, nullptr, false, false, 100.0, meterAttack_ms, meterRelease_ms, detectorMode, meterCalibration, 0 };
+}
+
+/**
+\struct PluginParameterMetadata
+\ingroup Structures
+\brief
+The heap-allocated, read-only part of a PluginParameter: name, units, parsed string list and aux attributes.
+
+- parameters built from a PluginParameterDescriptor share one of these per descriptor for the whole module, and copies
+  of any parameter (e.g. the GUI's makePluginParameterVectorCopy( ) set) share their source's
+- the PluginParameter setters for these fields copy it first when it is shared (copy-on-write)
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct PluginParameterMetadata
+{
+	std::string controlName = "ControlName";	///< the name string for the parameter
+	std::string controlUnits = "Units";			///< the units string for the parameter
+	std::vector<std::string> stringList;		///< string list
+	std::string commaSeparatedStringList;		///< string list a somma separated string
+	std::map<uint32_t, AuxParameterAttribute> auxAttributes;	///< aux attributes by attributeID
+};
+
 
 /**
 \class PluginParameter
@@ -66,6 +155,9 @@ public:
     PluginParameter(int _controlID, const char* _controlName, double _meterAttack_ms, double _meterRelease_ms,
                     uint32_t _detectorMode, meterCal _meterCal = meterCal::kLinearMeter);
 
+	/** constructor from a shared, static descriptor; no per-instance strings are allocated */
+	explicit PluginParameter(const PluginParameterDescriptor& descriptor);
+
     /** constructor for NonVariableBoundControl */
     PluginParameter(int _controlID, const char* _controlName = "", controlVariableType _controlType = controlVariableType::kNonVariableBoundControl);
 
@@ -81,11 +173,11 @@ public:
     uint32_t getControlID() { return controlID; }			///< get ID value
     void setControlID(uint32_t cid) { controlID = cid; }	///< set ID value
 
-    const char* getControlName() { return controlName.c_str(); }			///< get name as const char*
-    void setControlName(const char* name) { controlName.assign(name); }		///< set name as const char*
+    const char* getControlName() { return metadata->controlName.c_str(); }			///< get name as const char*
+    void setControlName(const char* name) { editMetadata().controlName.assign(name); }		///< set name as const char*
 
-    const char* getControlUnits() { return controlUnits.c_str(); }			///< get units as const char*
-    void setControlUnits(const char* units) { controlUnits.assign(units); }	///< set units as const char*
+    const char* getControlUnits() { return metadata->controlUnits.c_str(); }			///< get units as const char*
+    void setControlUnits(const char* units) { editMetadata().controlUnits.assign(units); }	///< set units as const char*
 
     controlVariableType getControlVariableType() { return controlType; }						///< get variable type associated with parameter
     void setControlVariableType(controlVariableType ctrlVarType) { controlType = ctrlVarType; }	///< set variable type associated with parameter
@@ -156,7 +248,7 @@ public:
     void setEnableVSTSampleAccurateAutomation(bool value) { enableVSTSampleAccurateAutomation = value; }///< set VST3 sample accurate automation
 
 	// --- for aux attributes
-	AuxParameterAttribute* getAuxAttribute(uint32_t attributeID);										///< get aux data
+	const AuxParameterAttribute* getAuxAttribute(uint32_t attributeID);									///< get aux data (read-only: it may be shared; write with setAuxAttribute( ))
 	uint32_t setAuxAttribute(uint32_t attributeID, const AuxParameterAttribute& auxParameterAtribute);	///< set aux data
 
 	/**
@@ -184,6 +276,8 @@ public:
 		}
 		else
 			setAtomicControlValueDouble(actualParamValue);
+
+		writeToSnapshot(actualParamValue, true);
 	}
 
 	/**
@@ -192,8 +286,10 @@ public:
 	\param normalizedValue parameter value as a regular double
 	\param applyTaper add the control taper during the operation
 	\param ignoreParameterSmoothing flag to ignore smoothing operation and write directly to atomic double
+	\param publishSnapshot false when the caller (the audio thread) updates the bound variable itself; the value still
+	       goes into the snapshot's master copy so the next publish carries it
 	*/
-	inline double setControlValueNormalized(double normalizedValue, bool applyTaper = true, bool ignoreParameterSmoothing = false)
+	inline double setControlValueNormalized(double normalizedValue, bool applyTaper = true, bool ignoreParameterSmoothing = false, bool publishSnapshot = true)
 	{
 		// --- set according to smoothing option
 		double actualParamValue = getControlValueWithNormalizedValue(normalizedValue, applyTaper);
@@ -209,9 +305,25 @@ public:
 		else
 			setAtomicControlValueDouble(actualParamValue);
 
+		writeToSnapshot(actualParamValue, publishSnapshot);
+
 		return actualParamValue;
 	}
 
+	/**
+	\brief attach the parameter to its slot in the owner's ParameterSnapshot and seed the slot with the current value
+
+	\param snapshot the snapshot (nullptr to detach)
+	\param index this parameter's index in the snapshot
+	*/
+	void setParameterSnapshot(ParameterSnapshot* snapshot, uint32_t index)
+	{
+		parameterSnapshot = snapshot;
+		snapshotIndex = index;
+		if (parameterSnapshot)
+			parameterSnapshot->writeValue(snapshotIndex, getAtomicControlValueFloat());
+	}
+
 	/**
 	\brief the main function to access the underlying atomic double value as a string
 
@@ -224,14 +336,14 @@ public:
 
 	\return number of strings
 	*/
-	size_t getStringCount(){return stringList.size();}
+	size_t getStringCount(){return metadata->stringList.size();}
 
 	/**
 	\brief get the strings in a string-list control as a comma separated list
 
 	\return comma separated list as a const char*
 	*/
-	const char* getCommaSeparatedStringList() {return commaSeparatedStringList.c_str();}
+	const char* getCommaSeparatedStringList() {return metadata->commaSeparatedStringList.c_str();}
 
 	/**
 	\brief convert the string-list into a comma-separated list (during construction)
@@ -241,7 +353,7 @@ public:
 	/**
 	\brief set the string-list using a vector of strings
 	*/
-	void setStringList(std::vector<std::string> _stringList) {stringList = _stringList;}
+	void setStringList(std::vector<std::string> _stringList) {editMetadata().stringList = _stringList;}
 
 	/** get a string-list string using the index */
 	std::string getStringByIndex(uint32_t index);
@@ -360,6 +472,7 @@ public:
 	*/
 	int findStringIndex(std::string searchString)
     {
+        const std::vector<std::string>& stringList = metadata->stringList;
         auto it = std::find(stringList.begin (), stringList.end (), searchString);
 
         if (it == stringList.end())
@@ -503,6 +616,37 @@ public:
 		return false;
 	}
 
+	/**
+	\brief perform the variable binding update with a value taken from the ParameterSnapshot rather than the atomic
+
+	\param value the value to write into the bound variable
+	\return true if there is a bound variable
+	*/
+	bool updateInBoundVariable(double value)
+	{
+		if (boundVariableUInt)
+		{
+			*boundVariableUInt = (uint32_t)value;
+			return true;
+		}
+		else if (boundVariableInt)
+		{
+			*boundVariableInt = (int)value;
+			return true;
+		}
+		else if (boundVariableFloat)
+		{
+			*boundVariableFloat = (float)value;
+			return true;
+		}
+		else if (boundVariableDouble)
+		{
+			*boundVariableDouble = value;
+			return true;
+		}
+		return false;
+	}
+
 	/**
 	\brief perform the variable binding update on meter data
 
@@ -533,6 +677,22 @@ public:
 		return false;
 	}
 
+	/**
+	\brief check whether the GUI needs to hear about the current value; remembers it when it does
+
+	\param threshold normalized change that counts as a change (GUI_METER_CHANGE_THRESHOLD for meters)
+	\return true if the normalized value moved by more than threshold since the last true return
+	*/
+	inline bool checkGUIValueChange(double threshold)
+	{
+		double normalizedValue = getControlValueNormalized();
+		if (fabs(normalizedValue - guiNotifiedValue) <= threshold)
+			return false;
+
+		guiNotifiedValue = normalizedValue;
+		return true;
+	}
+
 	/**
 	\brief stores the update queue for VST3 sample accuate automation; note this is only used during actual DAW runs with automation engaged
 
@@ -554,9 +714,7 @@ public:
 			return *this;
 
 		controlID = aPluginParameter.controlID;
-		controlName = aPluginParameter.controlName;
-		controlUnits = aPluginParameter.controlUnits;
-		commaSeparatedStringList = aPluginParameter.commaSeparatedStringList;
+		metadata = aPluginParameter.metadata;
 		controlType = aPluginParameter.controlType;
 		minValue = aPluginParameter.minValue;
 		maxValue = aPluginParameter.maxValue;
@@ -564,7 +722,6 @@ public:
 		controlTaper = aPluginParameter.controlTaper;
 		controlValueAtomic = aPluginParameter.getAtomicControlValueFloat();
 		displayPrecision = aPluginParameter.displayPrecision;
-		stringList = aPluginParameter.stringList;
 		useParameterSmoothing = aPluginParameter.useParameterSmoothing;
 		smoothingType = aPluginParameter.smoothingType;
 		smoothingTimeMsec = aPluginParameter.smoothingTimeMsec;
@@ -581,8 +738,6 @@ public:
 
 protected:
     int controlID = -1;							///< the ID value for the parameter
-    std::string controlName = "ControlName";	///< the name string for the parameter
-    std::string controlUnits = "Units";			///< the units string for the parameter
     controlVariableType controlType = controlVariableType::kDouble; ///< the control type
 
     // --- min/max/def
@@ -601,6 +756,20 @@ protected:
     double getAtomicControlValueDouble() const { return (double)controlValueAtomic.load(std::memory_order_relaxed); }		///< set atomic variable with double
 	void setAtomicControlValueDouble(double value) { controlValueAtomic.store((float)value, std::memory_order_relaxed); }	///< get atomic variable as double
 
+    // --- snapshot slot; meters only flow outbound so they never write to it
+    ParameterSnapshot* parameterSnapshot = nullptr;	///< owner's snapshot (not copied with the parameter)
+    double guiNotifiedValue = -1.0;					///< normalized value last reported by checkGUIValueChange( ); -1 forces the first report
+    uint32_t snapshotIndex = 0;						///< our slot in the snapshot
+	void writeToSnapshot(double value, bool publish)	///< write value to the master copy, optionally publish
+	{
+		if (!parameterSnapshot || controlType == controlVariableType::kMeter)
+			return;
+
+		parameterSnapshot->writeValue(snapshotIndex, (float)value);
+		if (publish)
+			parameterSnapshot->publish();
+	}
+
     std::atomic<float> smoothedTargetValueAtomic;	///< the underlying atomic variable TARGET for smoothing
     void setSmoothedTargetValue(double value){ smoothedTargetValueAtomic.store((float)value); }	///< set atomic TARGET smoothing variable with double
     double getSmoothedTargetValue() const { return (double)smoothedTargetValueAtomic.load(); }	///< set atomic TARGET smoothing variable with double
@@ -609,9 +778,19 @@ protected:
     taper controlTaper = taper::kLinearTaper;	///< the taper
     uint32_t displayPrecision = 2;				///< sig digits for display
 
-    // --- for enumerated string list
-    std::vector<std::string> stringList;		///< string list
-    std::string commaSeparatedStringList;		///< string list a somma separated string
+    // --- name, units, string list and aux attributes; shared, copied on write
+    std::shared_ptr<PluginParameterMetadata> metadata;	///< never null
+
+	/** the metadata for writing; makes our own copy first if it is shared */
+	PluginParameterMetadata& editMetadata()
+	{
+		if (metadata.use_count() > 1)
+			metadata = std::make_shared<PluginParameterMetadata>(*metadata);
+		return *metadata;
+	}
+
+	/** the module-wide metadata for a descriptor, built on first use */
+	static std::shared_ptr<PluginParameterMetadata> getSharedMetadata(const PluginParameterDescriptor& descriptor);
 
     // --- gui specific
     bool appendUnits = true;					///< flag to append units in GUI controls (use with several built-in custom views)
@@ -773,10 +952,6 @@ private:
     int* boundVariableInt = nullptr;				///< bound variable as int
     float* boundVariableFloat = nullptr;			///< bound variable as float
     double* boundVariableDouble = nullptr;			///< bound variable as double
-
-	typedef std::map<uint32_t, AuxParameterAttribute*> auxParameterAttributeMap; ///< Aux attributes that can be stored on this object (similar to VSTGUI4) makes it easy to add extra data in the future
-	auxParameterAttributeMap auxAttributeMap;		///< map of aux attributes
-
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include <sstream>
 #include <vector>
 #include <stdint.h>
+#include <atomic>
 
 #include "readerwriterqueue.h"
 #include "atomicops.h"
@@ -27,6 +28,7 @@
 class IGUIPluginConnector;
 class IGUIWindowFrame;
 class IGUIView;
+class ControlDirtySet;
 
 #ifdef AUPLUGIN
 #import <CoreFoundation/CoreFoundation.h>
@@ -1076,6 +1078,14 @@ struct ProcessBufferInfo
 	float** outputs = nullptr;		///< audio output buffers
 	float** auxInputs = nullptr;	///< aux (sidechain) input buffers
 	float** auxOutputs = nullptr;	///< aux outputs - for future use
+
+	// --- 64-bit buffers (VST3 kSample64); the shell sets these INSTEAD of the float buffers, and only
+	//     when PluginDescriptor::processDoublePrecision is set
+	double** inputs64 = nullptr;		///< 64-bit audio input buffers
+	double** outputs64 = nullptr;		///< 64-bit audio output buffers
+	double** auxInputs64 = nullptr;		///< 64-bit aux (sidechain) input buffers
+	double** auxOutputs64 = nullptr;	///< 64-bit aux outputs - for future use
+
 	uint32_t numAudioInChannels = 0;		///< audio input channel count
 	uint32_t numAudioOutChannels = 0;		///< audio output channel count
 	uint32_t numAuxAudioInChannels = 0;		///< aux input channel count
@@ -1136,6 +1146,49 @@ struct ProcessFrameInfo
 	IMidiEventQueue* midiEventQueue = nullptr;	///< MIDI event queue
 };
 
+/**
+\struct ProcessBlockInfo
+\ingroup Structures
+\brief
+Information package that arrives with each block of frames when PluginDescriptor::processBlocks is set; called internally
+from the buffer process function. Parameters are constant for the whole block (it never spans an automation point).
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct ProcessBlockInfo
+{
+	ProcessBlockInfo(){ }
+
+	// --- the host's channel buffers; this block is frames [blockStartFrame, blockStartFrame + numFrames)
+	float** inputs = nullptr;		///< audio input buffers
+	float** outputs = nullptr;		///< audio output buffers
+	float** auxInputs = nullptr;	///< aux (sidechain) input buffers
+	float** auxOutputs = nullptr;	///< aux outputs - for future use
+
+	// --- 64-bit host buffers; when inputs64/outputs64 are set the float buffers are not
+	double** inputs64 = nullptr;		///< 64-bit audio input buffers
+	double** outputs64 = nullptr;		///< 64-bit audio output buffers
+	double** auxInputs64 = nullptr;		///< 64-bit aux (sidechain) input buffers
+	double** auxOutputs64 = nullptr;	///< 64-bit aux outputs - for future use
+
+	uint32_t blockStartFrame = 0;	///< offset of the first frame of this block in the buffers
+	uint32_t numFrames = 0;			///< frames in this block (1 to MAX_PROCESS_BLOCK_FRAMES)
+
+	uint32_t numAudioInChannels = 0;		///< audio input channel count
+	uint32_t numAudioOutChannels = 0;		///< audio output channel count
+	uint32_t numAuxAudioInChannels = 0;		///< aux input channel count
+	uint32_t numAuxAudioOutChannels = 0;	///< aux output channel count (not used)
+
+	ChannelIOConfig channelIOConfig;	///< input/output channel I/O configuration pair
+	ChannelIOConfig auxChannelIOConfig;	///< aux input/output channel I/O configuration pair
+
+	HostInfo* hostInfo = nullptr;			///< pointer to host data for this buffer
+	IMidiEventQueue* midiEventQueue = nullptr;	///< MIDI event queue
+	uint32_t numMidiFrames = 0;					///< fire midiEventQueue for the first numMidiFrames frames of this block (0 = no MIDI)
+};
+
 /**
 \struct AudioProcDescriptor
 \ingroup Structures
@@ -1193,6 +1246,8 @@ struct PluginDescriptor
     , pluginTypeCode(pluginType::kFXPlugin) // FX or synth
     , hasSidechain(0)
     , processFrames(1)                  /* default operation */
+    , processBlocks(0)                  /* default operation */
+    , processDoublePrecision(0)         /* default operation */
     , wantsMIDI(1)                      /* default operation */
     , hasCustomGUI(1)
     , latencyInSamples(0)
@@ -1212,6 +1267,8 @@ struct PluginDescriptor
 
     bool hasSidechain = false;		///< sidechain flag
     bool processFrames = true;		///< want frames (default)
+    bool processBlocks = false;		///< want blocks of up to MAX_PROCESS_BLOCK_FRAMES through processAudioBlock( ) instead of frames
+    bool processDoublePrecision = false;	///< accept 64-bit host buffers (ProcessBufferInfo::inputs64/outputs64); requires processBlocks
     bool wantsMIDI = true;			///< want MIDI (don't need to actually use it)
     bool hasCustomGUI = true;		///< default on
     uint32_t latencyInSamples = 0;	///< latency
@@ -1405,6 +1462,15 @@ public:
 	//     thread-safe mechanism that you design */
 	virtual void pushDataValue(double data) { }
 
+	/**    push a block of data values into the view in one call, e.g. once per audio buffer\n
+	//     The default forwards each value to pushDataValue( ); views with a SampleBlockRing override\n
+	//     this to copy the whole block at once and drop what does not fit */
+	virtual void pushDataBlock(const float* data, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			pushDataValue((double)data[i]);
+	}
+
 	/**    send a message into the view
 	//     The derived class should implement a lock-free ring buffer to store the message.\n
 	//     and handle all messaging in a thread-safe manner\n
@@ -1512,6 +1578,9 @@ public:
 	/**  get plugin parameter as normalize value */
 	virtual double getNormalizedPluginParameter(int32_t controlID) { return 0.0; }
 
+	/**  the plugin's set of changed outbound controls; nullptr means the GUI must poll every writeable control */
+	virtual ControlDirtySet* getOutboundDirtySet() { return nullptr; }
+
 	/**  set plugin parameter with normalize value */
 	virtual void setNormalizedPluginParameter(int32_t controlID, double value) { }
 
@@ -1566,6 +1635,10 @@ public:
 
 	/** Fire off the next <IDI event */
 	virtual bool fireMidiEvents(uint32_t uSampleOffset) = 0;
+
+	/** Get the sample offset of one of this buffer's events (optional); block processing starts a block at each
+	    reported offset and fires only there. Queues that return false are fired on every frame instead, in one-frame blocks. */
+	virtual bool getEventSampleOffset(uint32_t eventIndex, uint32_t& sampleOffset) { return false; }
 };
 
 
@@ -1593,6 +1666,514 @@ public:
 	/**    Get the sample-accurate value of the parameter at the next sample offset, determined by an internal counter
 	//     Returns true if dNextValue is different than the previous value */
 	virtual bool getNextValue(double& _nextValue) = 0;
+
+	/**    Get the number of automation points queued for this buffer; -1 if the queue can only be polled with getNextValue( )
+	//     (the default). Queues that report points let the buffer be split into sub-blocks at the point offsets */
+	virtual int32_t getPointCount() { return -1; }
+
+	/**    Get the sample offset and normalized value of automation point _index; returns false if there is no such point */
+	virtual bool getPoint(int32_t _index, int32_t& _sampleOffset, double& _value) { return false; }
+};
+
+/**
+\class ParameterPointQueue
+\ingroup ASPiK-Core
+\brief
+The ParameterPointQueue object is an IParameterUpdateQueue that reports its automation points, so PluginBase can split
+the buffer into sub-blocks at the point offsets instead of polling the queue once per sample.
+
+A shell copies each host queue into one of these per buffer (for VST3, the points of an IParamValueQueue) and hands
+that to the parameter with setParameterUpdateQueue( ). Queues that only implement getNextValue( ) still work, but they
+make block processing run one frame per block for the whole buffer.
+
+- clear( ) at the top of each buffer, then addPoint( ) in ascending offset order
+- holds up to kMaxPoints points; addPoint( ) returns false when full and the point is lost
+- getNextValue( ) / getValueAtOffset( ) give the polled view of the same points, for callers that still poll
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class ParameterPointQueue : public IParameterUpdateQueue
+{
+public:
+	ParameterPointQueue(uint32_t _parameterIndex = 0) { parameterIndex = _parameterIndex; }
+	virtual ~ParameterPointQueue() {}
+
+	/** start a new buffer: forget the previous buffer's points and restart the polling counter */
+	void clear()
+	{
+		numPoints = 0;
+		nextPoint = 0;
+		sampleCounter = 0;
+	}
+
+	/** add a point; offsets must arrive in ascending order, as hosts deliver them
+	\return false if the queue is full */
+	bool addPoint(int32_t sampleOffset, double value)
+	{
+		if (numPoints >= kMaxPoints)
+			return false;
+
+		points[numPoints].sampleOffset = sampleOffset;
+		points[numPoints].value = value;
+		numPoints++;
+		return true;
+	}
+
+	virtual uint32_t getParameterIndex() { return parameterIndex; }
+
+	/** the value of the last point at or before _sampleOffset */
+	virtual bool getValueAtOffset(long int _sampleOffset, double _previousValue, double& _nextValue)
+	{
+		_nextValue = _previousValue;
+		for (uint32_t i = 0; i < numPoints && points[i].sampleOffset <= _sampleOffset; i++)
+			_nextValue = points[i].value;
+		return _nextValue != _previousValue;
+	}
+
+	/** one call per sample: returns the points that land on the current sample, then advances */
+	virtual bool getNextValue(double& _nextValue)
+	{
+		bool changed = false;
+		while (nextPoint < numPoints && points[nextPoint].sampleOffset <= sampleCounter)
+		{
+			_nextValue = points[nextPoint++].value;
+			changed = true;
+		}
+		sampleCounter++;
+		return changed;
+	}
+
+	virtual int32_t getPointCount() { return (int32_t)numPoints; }
+
+	virtual bool getPoint(int32_t _index, int32_t& _sampleOffset, double& _value)
+	{
+		if (_index < 0 || (uint32_t)_index >= numPoints)
+			return false;
+
+		_sampleOffset = points[_index].sampleOffset;
+		_value = points[_index].value;
+		return true;
+	}
+
+	static const uint32_t kMaxPoints = 64;	///< points per buffer
+
+protected:
+	struct Point
+	{
+		int32_t sampleOffset = 0;	///< offset into the buffer
+		double value = 0.0;			///< normalized value
+	};
+	Point points[kMaxPoints];					///< this buffer's points, ascending by offset
+	uint32_t numPoints = 0;						///< points this buffer
+	uint32_t nextPoint = 0;						///< getNextValue( ): next point not yet returned
+	int32_t sampleCounter = 0;					///< getNextValue( ): current sample
+	uint32_t parameterIndex = 0;				///< the parameter this queue automates
+};
+
+/**
+\class TripleBuffer
+\ingroup ASPiK-Core
+\brief
+The TripleBuffer object hands the newest of three slots from one writer thread to one reader thread without either
+of them ever waiting; the slots themselves are filled and read in place.
+
+- the writer fills getBack( ) and publish( )es it: one atomic exchange swaps it with the hand-over slot
+- the reader calls acquire( ): one atomic load when nothing was published since the last call, one atomic exchange
+  to take the hand-over slot when something was
+- an unread slot is simply replaced by the next publish( ); only the latest value matters
+- getSlot( ) and reset( ) are for setup and teardown, while neither thread is using the buffer
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() {}
+	~TripleBuffer() {}
+
+	/** writer side: the slot to fill before publish( ) */
+	inline T& getBack() { return slots[backIndex]; }
+
+	/** writer side: make the back slot the newest; the writer gets the old hand-over slot as its next back slot */
+	inline void publish()
+	{
+		backIndex = middleIndex.exchange(backIndex | kFreshFlag, std::memory_order_acq_rel) & kIndexMask;
+	}
+
+	/** reader side: the newest slot if one was published since the last call, nullptr otherwise */
+	inline T* acquire()
+	{
+		if ((middleIndex.load(std::memory_order_relaxed) & kFreshFlag) == 0)
+			return nullptr;
+
+		frontIndex = middleIndex.exchange(frontIndex, std::memory_order_acq_rel) & kIndexMask;
+		return &slots[frontIndex];
+	}
+
+	/** setup/teardown: slot i of the three, whatever its current role */
+	T& getSlot(uint32_t i) { return slots[i]; }
+
+	/** setup: forget any unread publish( ) */
+	void reset()
+	{
+		backIndex = 0;
+		middleIndex.store(1, std::memory_order_relaxed);
+		frontIndex = 2;
+	}
+
+protected:
+	enum { kIndexMask = 3, kFreshFlag = 4 };
+
+	T slots[3]{};							///< back, hand-over and front slots (roles rotate); value-initialized, so pointer slots start null
+	uint32_t backIndex = 0;					///< writer owned
+	std::atomic<uint32_t> middleIndex{ 1 };	///< the hand-over slot, plus kFreshFlag when it holds an unread value
+	uint32_t frontIndex = 2;				///< reader owned
+};
+
+/**
+\class ParameterSnapshot
+\ingroup ASPiK-Core
+\brief
+Lock-free triple-buffered block of parameter values (one float per parameter index) shared between the
+writer threads (GUI, host, presets) and the audio thread.
+
+- writers store into a master copy with writeValue( ) and publish( ) the whole block: it is copied into
+  the back buffer of a TripleBuffer, which swaps it with the middle buffer in a single atomic exchange
+- the audio thread calls acquire( ) once per buffer: one atomic load when nothing changed, one atomic
+  exchange to take the newest block when something did; every value in a block comes from the same publish
+- writers serialize with a try-lock; a writer that finds it taken raises a pending flag and leaves, and
+  the lock holder publishes again before it lets go, so no thread ever waits and no write is lost
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class ParameterSnapshot
+{
+public:
+	ParameterSnapshot() {}
+	~ParameterSnapshot() { destroy(); }
+
+	/** allocate the blocks; not real-time safe, call during parameter initialization only */
+	void create(uint32_t _numValues)
+	{
+		destroy();
+		numValues = _numValues;
+		masterValues = new std::atomic<float>[numValues];
+		for (uint32_t i = 0; i < kNumBuffers; i++)
+		{
+			buffers.getSlot(i) = new float[numValues];
+			memset(buffers.getSlot(i), 0, sizeof(float)*numValues);
+		}
+		for (uint32_t i = 0; i < numValues; i++)
+			masterValues[i].store(0.f, std::memory_order_relaxed);
+
+		buffers.reset();
+	}
+
+	/** number of values per block */
+	uint32_t getNumValues() { return numValues; }
+
+	/** writer side: update one value in the master copy (does not publish) */
+	inline void writeValue(uint32_t index, float value)
+	{
+		if (index < numValues)
+			masterValues[index].store(value, std::memory_order_relaxed);
+	}
+
+	/** writer side: publish the master copy as the newest block; never blocks */
+	void publish()
+	{
+		if (!masterValues)
+			return;
+
+		publishPending.store(true, std::memory_order_release);
+		while (publishPending.load(std::memory_order_acquire))
+		{
+			// --- someone else is publishing; they will see our pending flag
+			if (writerLock.test_and_set(std::memory_order_acquire))
+				return;
+
+			publishPending.store(false, std::memory_order_relaxed);
+
+			float* back = buffers.getBack();
+			for (uint32_t i = 0; i < numValues; i++)
+				back[i] = masterValues[i].load(std::memory_order_relaxed);
+
+			buffers.publish();
+
+			writerLock.clear(std::memory_order_release);
+		}
+	}
+
+	/** audio side: returns the newest block if one was published since the last call, nullptr otherwise */
+	inline const float* acquire()
+	{
+		if (!masterValues)
+			return nullptr;
+
+		float** front = buffers.acquire();
+		return front ? *front : nullptr;
+	}
+
+protected:
+	static const uint32_t kNumBuffers = 3;
+
+	void destroy()
+	{
+		delete[] masterValues;
+		masterValues = nullptr;
+		for (uint32_t i = 0; i < kNumBuffers; i++)
+		{
+			delete[] buffers.getSlot(i);
+			buffers.getSlot(i) = nullptr;
+		}
+		numValues = 0;
+	}
+
+	uint32_t numValues = 0;							///< values per block
+	std::atomic<float>* masterValues = nullptr;		///< writer-side master copy
+	TripleBuffer<float*> buffers;					///< back, middle and front blocks; the writer side runs under writerLock
+
+	std::atomic_flag writerLock = ATOMIC_FLAG_INIT;	///< writer try-lock
+	std::atomic<bool> publishPending{ false };		///< a publish arrived while the lock was held
+};
+
+/**
+\class ControlDirtySet
+\ingroup ASPiK-Core
+\brief
+The ControlDirtySet object is a lock-free set of controlIDs whose values changed, carried from the audio thread
+(outbound meters) to the GUI timer so the GUI touches only the controls that moved.
+
+- one bit per controlID below kMaxControlID, kept in atomic 64-bit words, plus a summary word with one bit per word;
+  markDirty( ) is two relaxed-order fetch_or( )s and never blocks
+- takeDirty( ) exchanges out only the words the summary names, so an idle set costs one atomic load per timer tick
+- controlIDs at or above kMaxControlID (the reserved range) cannot be marked individually; marking one raises an
+  overflow flag and isDirty( ) then reports every out-of-range ID as dirty for that tick
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class ControlDirtySet
+{
+public:
+	static const uint32_t kNumWords = 64;					///< one summary bit per word
+	static const uint32_t kMaxControlID = kNumWords * 64;	///< same span as MAX_DENSE_CONTROL_ID
+
+	ControlDirtySet() { clear(); }
+	~ControlDirtySet() {}
+
+	/** forget every mark, e.g. when the GUI opens */
+	void clear()
+	{
+		for (uint32_t i = 0; i < kNumWords; i++)
+			dirtyWords[i].store(0, std::memory_order_relaxed);
+		summaryWord.store(0, std::memory_order_relaxed);
+		overflow.store(false, std::memory_order_relaxed);
+	}
+
+	/** writer side: mark a controlID as changed; safe from the audio thread */
+	inline void markDirty(uint32_t controlID)
+	{
+		if (controlID >= kMaxControlID)
+		{
+			overflow.store(true, std::memory_order_release);
+			return;
+		}
+
+		uint32_t word = controlID >> 6;
+		dirtyWords[word].fetch_or(1ull << (controlID & 63), std::memory_order_release);
+		summaryWord.fetch_or(1ull << word, std::memory_order_release);
+	}
+
+	/** reader side: move the marks into words (kNumWords long, plus one trailing overflow word) and clear them */
+	/**
+	\param words destination; every word is written
+	\return true if anything was marked
+	*/
+	bool takeDirty(uint64_t* words)
+	{
+		uint64_t summary = summaryWord.exchange(0, std::memory_order_acq_rel);
+		for (uint32_t i = 0; i < kNumWords; i++)
+			words[i] = (summary & (1ull << i)) ? dirtyWords[i].exchange(0, std::memory_order_acq_rel) : 0;
+		words[kNumWords] = overflow.exchange(false, std::memory_order_acq_rel) ? 1 : 0;
+		return summary != 0 || words[kNumWords] != 0;
+	}
+
+	/** \return true if controlID is marked in words taken with takeDirty( ) */
+	static inline bool isDirty(const uint64_t* words, uint32_t controlID)
+	{
+		if (controlID >= kMaxControlID)
+			return words[kNumWords] != 0;
+		return (words[controlID >> 6] & (1ull << (controlID & 63))) != 0;
+	}
+
+protected:
+	std::atomic<uint64_t> dirtyWords[kNumWords];	///< one bit per controlID
+	std::atomic<uint64_t> summaryWord{ 0 };			///< one bit per non-empty dirtyWords entry
+	std::atomic<bool> overflow{ false };			///< an out-of-range controlID was marked
+};
+
+/**
+\class SampleBlockRing
+\ingroup ASPiK-Core
+\brief
+The SampleBlockRing object is a wait-free single-producer/single-consumer ring that moves whole blocks of samples,
+used to feed custom views (WaveView, SpectrumView) from the audio thread.
+
+- write( ) copies as much of a block as fits with at most two memcpy( )s and one release store; what does not fit
+  is dropped (and counted) rather than waiting or allocating
+- read( ) copies out up to a requested count the same way, so the GUI drains a whole timer tick in one call
+- the capacity is rounded up to a power of 2 and the indices run freely, so full and empty need no extra flag
+- create( ) allocates and is not real-time safe; call it before either side runs
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <typename T>
+class SampleBlockRing
+{
+public:
+	SampleBlockRing() {}
+	~SampleBlockRing() { delete[] buffer; }
+
+	/** allocate the ring
+	\param minCapacity the ring holds at least this many samples
+	*/
+	void create(uint32_t minCapacity)
+	{
+		delete[] buffer;
+		capacity = 1;
+		while (capacity < minCapacity)
+			capacity <<= 1;
+		mask = capacity - 1;
+		buffer = new T[capacity];
+		writeIndex.store(0, std::memory_order_relaxed);
+		readIndex.store(0, std::memory_order_relaxed);
+		droppedCount.store(0, std::memory_order_relaxed);
+	}
+
+	/** producer side: copy in a block; the part that does not fit is dropped
+	\param data the samples
+	\param count number of samples
+	\return the number of samples written
+	*/
+	uint32_t write(const T* data, uint32_t count)
+	{
+		if (!buffer || count == 0)
+			return 0;
+
+		uint32_t w = writeIndex.load(std::memory_order_relaxed);
+		uint32_t space = capacity - (w - readIndex.load(std::memory_order_acquire));
+		uint32_t numWrite = count < space ? count : space;
+		if (numWrite < count)
+			droppedCount.store(droppedCount.load(std::memory_order_relaxed) + (count - numWrite), std::memory_order_relaxed);	// single producer
+
+		uint32_t start = w & mask;
+		uint32_t first = numWrite < capacity - start ? numWrite : capacity - start;
+		memcpy(buffer + start, data, first * sizeof(T));
+		memcpy(buffer, data + first, (numWrite - first) * sizeof(T));
+
+		writeIndex.store(w + numWrite, std::memory_order_release);
+		return numWrite;
+	}
+
+	/** consumer side: copy out up to maxCount samples, oldest first
+	\param data destination
+	\param maxCount size of data
+	\return the number of samples read
+	*/
+	uint32_t read(T* data, uint32_t maxCount)
+	{
+		if (!buffer || maxCount == 0)
+			return 0;
+
+		uint32_t r = readIndex.load(std::memory_order_relaxed);
+		uint32_t available = writeIndex.load(std::memory_order_acquire) - r;
+		uint32_t numRead = maxCount < available ? maxCount : available;
+
+		uint32_t start = r & mask;
+		uint32_t first = numRead < capacity - start ? numRead : capacity - start;
+		memcpy(data, buffer + start, first * sizeof(T));
+		memcpy(data + first, buffer, (numRead - first) * sizeof(T));
+
+		readIndex.store(r + numRead, std::memory_order_release);
+		return numRead;
+	}
+
+	/** consumer side: throw away everything written so far */
+	void discard() { readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release); }
+
+	/** \return the ring size in samples */
+	uint32_t getCapacity() { return capacity; }
+
+	/** \return samples dropped because the ring was full */
+	uint32_t getDroppedCount() { return droppedCount.load(std::memory_order_relaxed); }
+
+protected:
+	T* buffer = nullptr;							///< the ring
+	uint32_t capacity = 0;							///< power of 2
+	uint32_t mask = 0;								///< capacity - 1
+	std::atomic<uint32_t> writeIndex{ 0 };			///< free-running, producer owned
+	std::atomic<uint32_t> readIndex{ 0 };			///< free-running, consumer owned
+	std::atomic<uint32_t> droppedCount{ 0 };		///< samples lost to a full ring
+};
+
+/**
+\class LatestValueMailbox
+\ingroup ASPiK-Core
+\brief
+The LatestValueMailbox object hands the newest copy of a small structure from one thread to another (by value, over a
+TripleBuffer), used where only the latest state matters, e.g. filter coefficient snapshots for the FilterCurveView.
+
+- write( ) never waits and never fails: an unread value is simply replaced by the newer one
+- read( ) returns false when nothing new arrived since the last read, so the reader can skip its work
+- one writer thread and one reader thread; T must be copyable without allocating
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <typename T>
+class LatestValueMailbox
+{
+public:
+	LatestValueMailbox() {}
+	~LatestValueMailbox() {}
+
+	/** writer side: publish a value, replacing any the reader has not taken yet
+	\param value the new value
+	*/
+	void write(const T& value)
+	{
+		slots.getBack() = value;
+		slots.publish();
+	}
+
+	/** reader side: take the newest value, if there is one
+	\param value receives the value
+	\return true if a value arrived since the last read
+	*/
+	bool read(T& value)
+	{
+		T* newest = slots.acquire();
+		if (!newest)
+			return false;
+
+		value = *newest;
+		return true;
+	}
+
+protected:
+	TripleBuffer<T> slots;	///< one slot each for the writer, the reader and the hand-over
 };
 
 // --------------------------------------------------------------------------------------------------------------------------- //
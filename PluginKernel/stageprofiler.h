@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------
+//    Quadra Plugin Kernel File:  stageprofiler.h
+//
+/**
+    \file   stageprofiler.h
+    \author Christian George
+    \date   01-June-2019
+    \brief  optional per-stage timing of the audio path
+    		- compiled in only when ENABLE_STAGE_PROFILING is defined in the
+    		  project settings (like HAVE_FFTW); without it the
+    		  PROFILE_STAGE_BEGIN/END macros expand to nothing
+    		- PluginCore publishes the per-stage loads as outbound meters and
+    		  logs min/avg/max per stage on reset( ) and destruction
+    		- every timed span can also go to a TraceRecorder for a timeline
+*/
+// -----------------------------------------------------------------------------
+#ifndef _stageprofiler_h
+#define _stageprofiler_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "tracerecorder.h"
+
+/**
+\enum profiledStage
+\ingroup Constants-Enums
+\brief
+The timed stages of one buffer.
+
+- kParameterSync: syncInBoundVariables( ), sample-accurate updates and cooking (updateParameters( ))
+- kSplitter, kModFilter: the graph stages (the LFO runs inside the ModFilter and is counted there)
+- kMix: the graph's mix steps (the parallel flow's 50/50 sum)
+- kInputOutput: moving samples between the host buffers and the graph
+*/
+enum profiledStage { kParameterSync, kSplitter, kModFilter, kMix, kInputOutput, kNumProfiledStages };
+
+/** \return the profiledStage names, kNumProfiledStages long */
+inline const char* const* getProfiledStageNames()
+{
+	static const char* stageNames[kNumProfiledStages] = { "param sync", "splitter", "modfilter", "mix", "i/o" };
+	return stageNames;
+}
+
+/**
+\class StageProfiler
+\ingroup ASPiK-Core
+\brief
+The StageProfiler object accumulates the time spent in each profiledStage over one buffer, then folds the totals into
+running statistics and a CPU load relative to the buffer's real-time budget (frames / sample rate).
+
+- steady_clock is used rather than rdtsc: it is portable and does not need the TSC frequency to convert to seconds
+- the audio thread only adds to fixed arrays; nothing allocates or locks
+- getReport( ) formats the statistics; call it off the audio thread
+- with a TraceRecorder attached, addStageSpan( ) also records each span for a timeline
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class StageProfiler
+{
+public:
+	StageProfiler(void) { clearStatistics(); }	/* C-TOR */
+	~StageProfiler(void) {}						/* D-TOR */
+
+	/** \return a timestamp in nanoseconds */
+	static inline uint64_t now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/** forget all statistics, e.g. on reset( ) */
+	void clearStatistics()
+	{
+		for (uint32_t s = 0; s < kNumProfiledStages; s++)
+		{
+			bufferNanoseconds[s] = 0;
+			minNanoseconds[s] = 0;
+			maxNanoseconds[s] = 0;
+			sumNanoseconds[s] = 0.0;
+			stageLoad[s] = 0.f;
+		}
+		totalLoad = 0.f;
+		maxTotalLoad = 0.f;
+		numBuffers = 0;
+	}
+
+	/** start timing a buffer */
+	/**
+	\param numFrames frames in the buffer
+	\param sampleRate the current sample rate
+	*/
+	void beginBuffer(uint32_t numFrames, double sampleRate)
+	{
+		for (uint32_t s = 0; s < kNumProfiledStages; s++)
+			bufferNanoseconds[s] = 0;
+		budgetNanoseconds = sampleRate > 0.0 ? 1.0e9 * numFrames / sampleRate : 0.0;
+	}
+
+	/** add time to a stage of the current buffer */
+	inline void addStageTime(uint32_t stage, uint64_t nanoseconds)
+	{
+		if (stage < kNumProfiledStages)
+			bufferNanoseconds[stage] += nanoseconds;
+	}
+
+	/** add a timed span to a stage of the current buffer, and to the trace if one is recording */
+	/**
+	\param stage the profiledStage
+	\param startTime span start from now( )
+	\param endTime span end from now( )
+	\param numFrames frames processed in the span
+	*/
+	inline void addStageSpan(uint32_t stage, uint64_t startTime, uint64_t endTime, uint32_t numFrames)
+	{
+		addStageTime(stage, endTime - startTime);
+		if (traceRecorder)
+			traceRecorder->record(TraceSpan(stage, numFrames, startTime, endTime));
+	}
+
+	/** attach (or, with nullptr, detach) a trace recorder; not while the audio thread runs */
+	void setTraceRecorder(TraceRecorder* _traceRecorder) { traceRecorder = _traceRecorder; }
+
+	/** fold the buffer's totals into the statistics and loads */
+	void endBuffer()
+	{
+		if (budgetNanoseconds <= 0.0)
+			return;
+
+		uint64_t bufferTotal = 0;
+		for (uint32_t s = 0; s < kNumProfiledStages; s++)
+		{
+			uint64_t ns = bufferNanoseconds[s];
+			if (numBuffers == 0 || ns < minNanoseconds[s])
+				minNanoseconds[s] = ns;
+			if (ns > maxNanoseconds[s])
+				maxNanoseconds[s] = ns;
+			sumNanoseconds[s] += (double)ns;
+			stageLoad[s] = (float)(ns / budgetNanoseconds);
+			bufferTotal += ns;
+		}
+		totalLoad = (float)(bufferTotal / budgetNanoseconds);
+		if (totalLoad > maxTotalLoad)
+			maxTotalLoad = totalLoad;
+		numBuffers++;
+	}
+
+	/** \return the stage's share of the last buffer's real-time budget (1.0 = the whole budget) */
+	float getStageLoad(uint32_t stage) { return stage < kNumProfiledStages ? stageLoad[stage] : 0.f; }
+
+	/** \return the whole path's share of the last buffer's real-time budget */
+	float getTotalLoad() { return totalLoad; }
+
+	/** format min/avg/max per stage, in microseconds per buffer */
+	/**
+	\param text destination
+	\param size size of text in chars
+	\return false if there are no statistics yet
+	*/
+	bool getReport(char* text, size_t size)
+	{
+		if (!text || size == 0 || numBuffers == 0)
+			return false;
+
+		const char* const* stageNames = getProfiledStageNames();
+		int length = snprintf(text, size, "stage profile over %llu buffers (us per buffer, min/avg/max); peak load %.1f%%\n",
+							  (unsigned long long)numBuffers, 100.0 * maxTotalLoad);
+		for (uint32_t s = 0; s < kNumProfiledStages && length > 0 && (size_t)length < size; s++)
+		{
+			length += snprintf(text + length, size - length, "  %-10s %9.2f %9.2f %9.2f\n", stageNames[s],
+							   minNanoseconds[s] * 1.0e-3, sumNanoseconds[s] * 1.0e-3 / numBuffers, maxNanoseconds[s] * 1.0e-3);
+		}
+		return true;
+	}
+
+private:
+	uint64_t bufferNanoseconds[kNumProfiledStages];	///< running totals for the current buffer
+	uint64_t minNanoseconds[kNumProfiledStages];	///< fastest buffer per stage
+	uint64_t maxNanoseconds[kNumProfiledStages];	///< slowest buffer per stage
+	double sumNanoseconds[kNumProfiledStages];		///< for the average
+	float stageLoad[kNumProfiledStages];			///< last buffer, fraction of the budget
+	float totalLoad = 0.f;							///< last buffer, fraction of the budget
+	float maxTotalLoad = 0.f;						///< worst buffer so far
+	double budgetNanoseconds = 0.0;					///< real-time length of the current buffer
+	uint64_t numBuffers = 0;						///< buffers folded into the statistics
+	TraceRecorder* traceRecorder = nullptr;			///< optional timeline
+};
+
+// --- scoped timing in the audio path; compiled out unless ENABLE_STAGE_PROFILING is defined
+#ifdef ENABLE_STAGE_PROFILING
+#define PROFILE_STAGE_BEGIN(NAME) uint64_t NAME##StartTime = StageProfiler::now()
+#define PROFILE_STAGE_END(PROFILER, NAME, STAGE, FRAMES) (PROFILER).addStageSpan(STAGE, NAME##StartTime, StageProfiler::now(), FRAMES)
+#else
+#define PROFILE_STAGE_BEGIN(NAME)
+#define PROFILE_STAGE_END(PROFILER, NAME, STAGE, FRAMES)
+#endif
+
+#endif
@@ -0,0 +1,176 @@
+// -----------------------------------------------------------------------------
+//    Quadra Plugin Kernel File:  tracerecorder.h
+//
+/**
+    \file   tracerecorder.h
+    \author Christian George
+    \date   01-June-2019
+    \brief  timeline recording of audio-path spans, written as a Chrome trace
+    		- the audio thread pushes fixed-size TraceSpan records into a
+    		  single-producer ReaderWriterQueue; a background thread drains
+    		  it into a Chrome trace-event JSON file (chrome://tracing, Perfetto)
+    		- off until start( ) is called; fed by StageProfiler, so it is only
+    		  compiled into the plugin with ENABLE_STAGE_PROFILING
+*/
+// -----------------------------------------------------------------------------
+#ifndef _tracerecorder_h
+#define _tracerecorder_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include "readerwriterqueue.h"
+
+// --- trace constants
+const unsigned int kTraceQueueLength = 16384;		///< spans buffered between drains (power of 2); more are dropped, never allocated
+const unsigned int kTraceDrainIntervalMsec = 20;	///< background drain period
+
+/**
+\struct TraceSpan
+\ingroup Structures
+\brief
+One timed span of the audio path: which stage, when it started and ended, and how many frames it covered.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct TraceSpan
+{
+	TraceSpan() {}
+	TraceSpan(uint32_t _stage, uint32_t _numFrames, uint64_t _startTime, uint64_t _endTime)
+		: stage(_stage), numFrames(_numFrames), startTime(_startTime), endTime(_endTime) {}
+
+	uint32_t stage = 0;			///< stage ID (index into the stage names given to start( ))
+	uint32_t numFrames = 0;		///< frames processed in the span
+	uint64_t startTime = 0;		///< nanoseconds, steady_clock
+	uint64_t endTime = 0;		///< nanoseconds, steady_clock
+};
+
+/**
+\class TraceRecorder
+\ingroup ASPiK-Core
+\brief
+The TraceRecorder object records TraceSpans from the audio thread and writes them to a Chrome trace-event JSON file
+from a background thread.
+
+- record( ) is wait-free: one relaxed atomic load when off; one try_enqueue( ) into the preallocated queue when on
+- a full queue drops the span (counted, and reported in the file's metadata) rather than blocking or allocating
+- start( ) and stop( ) must be called from one non-audio thread; the queue is allocated by the first start( ) and
+  kept until destruction, so the audio thread never sees it disappear
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class TraceRecorder
+{
+public:
+	TraceRecorder(void) {}			/* C-TOR */
+	~TraceRecorder(void)			/* D-TOR */
+	{
+		stop();
+		delete spanQueue;
+	}
+
+	/** open a trace file and start recording */
+	/**
+	\param path the JSON file to write
+	\param _stageNames names of the stage IDs used in record( ); the array must outlive the recording
+	\param _numStageNames number of names
+	\return true if the file was opened
+	*/
+	bool start(const char* path, const char* const* _stageNames, uint32_t _numStageNames)
+	{
+		stop();
+		if (!path)
+			return false;
+
+		traceFile = fopen(path, "w");
+		if (!traceFile)
+			return false;
+
+		if (!spanQueue)
+			spanQueue = new moodycamel::ReaderWriterQueue<TraceSpan, kTraceQueueLength>(kTraceQueueLength);
+
+		stageNames = _stageNames;
+		numStageNames = _numStageNames;
+		firstEvent = true;
+		droppedSpans.store(0, std::memory_order_relaxed);
+		fputs("{\"traceEvents\":[\n", traceFile);
+
+		draining.store(true, std::memory_order_relaxed);
+		drainThread = std::thread(&TraceRecorder::drainLoop, this);
+		recording.store(true, std::memory_order_release);
+		return true;
+	}
+
+	/** stop recording, write everything still queued and close the file */
+	void stop()
+	{
+		if (!traceFile)
+			return;
+
+		recording.store(false, std::memory_order_release);
+		draining.store(false, std::memory_order_relaxed);
+		if (drainThread.joinable())
+			drainThread.join();
+		drainQueue();
+
+		fprintf(traceFile, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedSpans\":%u}}\n",
+				droppedSpans.load(std::memory_order_relaxed));
+		fclose(traceFile);
+		traceFile = nullptr;
+	}
+
+	/** \return true while recording */
+	bool isRecording() { return recording.load(std::memory_order_relaxed); }
+
+	/** audio thread: record one span; does nothing unless recording */
+	inline void record(const TraceSpan& span)
+	{
+		if (!recording.load(std::memory_order_acquire))
+			return;
+
+		if (!spanQueue->try_enqueue(span))
+			droppedSpans.store(droppedSpans.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);	// single producer
+	}
+
+private:
+	void drainLoop()
+	{
+		while (draining.load(std::memory_order_relaxed))
+		{
+			drainQueue();
+			std::this_thread::sleep_for(std::chrono::milliseconds(kTraceDrainIntervalMsec));
+		}
+	}
+
+	/** one complete ("X") event per span; timestamps in microseconds as the format requires */
+	void drainQueue()
+	{
+		TraceSpan span;
+		while (spanQueue->try_dequeue(span))
+		{
+			const char* name = span.stage < numStageNames ? stageNames[span.stage] : "unknown";
+			fprintf(traceFile, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frames\":%u}}",
+					firstEvent ? "" : ",\n", name, span.startTime * 1.0e-3, (span.endTime - span.startTime) * 1.0e-3, span.numFrames);
+			firstEvent = false;
+		}
+	}
+
+	moodycamel::ReaderWriterQueue<TraceSpan, kTraceQueueLength>* spanQueue = nullptr;	///< audio thread -> drain thread
+	std::atomic<bool> recording{ false };		///< audio side gate
+	std::atomic<bool> draining{ false };		///< drain thread run flag
+	std::atomic<uint32_t> droppedSpans{ 0 };	///< spans lost to a full queue
+	std::thread drainThread;					///< background writer
+	FILE* traceFile = nullptr;					///< open while recording
+	const char* const* stageNames = nullptr;	///< event names by stage ID
+	uint32_t numStageNames = 0;					///< size of stageNames
+	bool firstEvent = true;						///< no comma before the first event
+};
+
+#endif
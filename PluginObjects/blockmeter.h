@@ -0,0 +1,184 @@
+#pragma once
+
+#ifndef __BlockMeter__
+#define __BlockMeter__
+
+#include <stdint.h>
+#include <math.h>
+#include "fxobjects.h"
+
+// --- SSE on x86/x64 (always there on x64, and with /arch:SSE or better on x86); plain loops elsewhere
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define BLOCK_METER_SSE 1
+#include <xmmintrin.h>
+#endif
+
+/** @file blockmeter.h
+\brief blockwise peak and RMS metering: the DSP path only stores samples into a tap buffer, and the reduction runs
+once per block, four lanes at a time
+*/
+
+// --- meter ballistics; applied per block on the audio side so the GUI's slower polling cannot miss a peak
+const double BLOCK_METER_PEAK_RELEASE_MSEC = 300.0;	///< peak hold falls to 36.7% in this time
+const double BLOCK_METER_RMS_WINDOW_MSEC = 300.0;	///< time constant of the mean-square average
+const unsigned int kBlockMeterTapSamples = MAX_PROCESS_BLOCK_FRAMES * 2;	///< one block, interleaved stereo
+
+/**
+@measureBlock
+\ingroup FX-Functions
+
+@brief finds the peak |x| and the sum of x^2 of a buffer; SSE where available, otherwise four-lane loops the
+compiler can vectorize
+
+\param samples the buffer
+\param count number of samples
+\param peak returns max |x|
+\param sumOfSquares returns the sum of x^2
+*/
+inline void measureBlock(const float* samples, uint32_t count, float& peak, float& sumOfSquares)
+{
+	uint32_t i = 0;
+	float peakLanes[4] = { 0.f, 0.f, 0.f, 0.f };
+	float sumLanes[4] = { 0.f, 0.f, 0.f, 0.f };
+
+#ifdef BLOCK_METER_SSE
+	const __m128 signBits = _mm_set1_ps(-0.f);
+	__m128 peak4 = _mm_setzero_ps();
+	__m128 sum4 = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(samples + i);
+		peak4 = _mm_max_ps(peak4, _mm_andnot_ps(signBits, x));
+		sum4 = _mm_add_ps(sum4, _mm_mul_ps(x, x));
+	}
+	_mm_storeu_ps(peakLanes, peak4);
+	_mm_storeu_ps(sumLanes, sum4);
+#else
+	for (; i + 4 <= count; i += 4)
+	{
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			float x = samples[i + lane];
+			float magnitude = fabsf(x);
+			peakLanes[lane] = magnitude > peakLanes[lane] ? magnitude : peakLanes[lane];
+			sumLanes[lane] += x * x;
+		}
+	}
+#endif
+
+	// --- the odd samples at the end
+	for (; i < count; i++)
+	{
+		float magnitude = fabsf(samples[i]);
+		peakLanes[0] = magnitude > peakLanes[0] ? magnitude : peakLanes[0];
+		sumLanes[0] += samples[i] * samples[i];
+	}
+
+	peak = peakLanes[0];
+	for (uint32_t lane = 1; lane < 4; lane++)
+		peak = peakLanes[lane] > peak ? peakLanes[lane] : peak;
+	sumOfSquares = (sumLanes[0] + sumLanes[1]) + (sumLanes[2] + sumLanes[3]);
+}
+
+/**
+\class BlockMeter
+\ingroup FX-Objects
+\brief
+The BlockMeter object meters a signal inside an FX object for an outbound meter parameter, at block rate.
+
+- tap( ) is called per frame in the processing loop and only stores the sample (no branches on the level, no math)
+- endBlock( ) reduces the block with measureBlock( ), then applies peak-hold release and RMS averaging once per
+  block; the per-block coefficients are recomputed only when the block size changes
+- the taps hold one block (MAX_PROCESS_BLOCK_FRAMES); call endBlock( ) at least that often
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class BlockMeter
+{
+public:
+	BlockMeter(void) {}		/* C-TOR */
+	~BlockMeter(void) {}	/* D-TOR */
+
+	/** clear the levels and taps for a new run of audio */
+	void reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		numTapped = 0;
+		peakLevel = 0.0;
+		meanSquare = 0.0;
+		coefficientFrames = 0;
+	}
+
+	/** store one frame; the right sample is ignored (pass 0.0) when the block is metered as mono */
+	inline void tap(double left, double right)
+	{
+		if (numTapped + 2 <= kBlockMeterTapSamples)
+		{
+			tapBuffer[numTapped] = (float)left;
+			tapBuffer[numTapped + 1] = (float)right;
+			numTapped += 2;
+		}
+	}
+
+	/** reduce the taps and update the meter levels; frames that were not tapped count as silence */
+	/**
+	\param numFrames frames in the block
+	\param numChannels 1 = the taps are mono (right is 0.0), 2 = stereo
+	*/
+	void endBlock(uint32_t numFrames, uint32_t numChannels)
+	{
+		float blockPeak = 0.f;
+		float blockSumOfSquares = 0.f;
+		measureBlock(tapBuffer, numTapped, blockPeak, blockSumOfSquares);
+		numTapped = 0;
+
+		if (numFrames == 0 || sampleRate <= 0.0)
+			return;
+
+		if (numFrames != coefficientFrames)
+			calculateCoefficients(numFrames);
+
+		// --- peak hold with release
+		double releasedPeak = peakLevel * peakRelease;
+		peakLevel = blockPeak > releasedPeak ? blockPeak : releasedPeak;
+
+		// --- one-pole mean square over blocks
+		double blockMeanSquare = blockSumOfSquares / (numFrames * (numChannels == 1 ? 1 : 2));
+		meanSquare += (blockMeanSquare - meanSquare) * rmsSmoothing;
+
+		// --- let silence reach zero instead of crawling through denormals
+		if (peakLevel < 1.0e-9)
+			peakLevel = 0.0;
+		if (meanSquare < 1.0e-18)
+			meanSquare = 0.0;
+	}
+
+	/** \return the held peak, linear */
+	float getPeak() { return (float)peakLevel; }
+
+	/** \return the RMS level, linear */
+	float getRMS() { return (float)sqrt(meanSquare); }
+
+protected:
+	/** per-block release and averaging coefficients for a block size */
+	void calculateCoefficients(uint32_t numFrames)
+	{
+		double blockSeconds = numFrames / sampleRate;
+		peakRelease = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC * blockSeconds / (BLOCK_METER_PEAK_RELEASE_MSEC * 0.001));
+		rmsSmoothing = 1.0 - exp(TLD_AUDIO_ENVELOPE_ANALOG_TC * blockSeconds / (BLOCK_METER_RMS_WINDOW_MSEC * 0.001));
+		coefficientFrames = numFrames;
+	}
+
+	float tapBuffer[kBlockMeterTapSamples] = { 0.f };	///< interleaved L/R samples of the current block
+	uint32_t numTapped = 0;								///< samples in tapBuffer
+	double sampleRate = 0.0;							///< current sample rate
+	double peakLevel = 0.0;								///< held peak
+	double meanSquare = 0.0;							///< averaged x^2
+	double peakRelease = 0.0;							///< per-block peak multiplier
+	double rmsSmoothing = 0.0;							///< per-block averaging step
+	uint32_t coefficientFrames = 0;						///< block size the coefficients were made for
+};
+
+#endif
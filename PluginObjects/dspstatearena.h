@@ -0,0 +1,402 @@
+#pragma once
+
+#ifndef __DSPStateArena__
+#define __DSPStateArena__
+
+#include <memory>
+#include <new>
+#include "fxobjects.h"
+
+/** @file dspstatearena.h
+\brief a contiguous, cache-aligned arena holding the hot DSP state of one plugin instance
+(biquad coefficients and z^-1 registers, detector envelopes and time constants) as a structure
+of arrays, plus the ArenaAudioFilter and ArenaAudioDetector views that process out of it.
+
+- the views are drop-in FilterType/DetectorType arguments for StaticLRFilterBank<> and StaticEnvelopeFollower<>
+- cold data (parameter structures, sample rate) stays in the views; only the data touched every
+  sample lives in the arena
+*/
+
+// --- arena sizing: 6 LR filter banks x 2 filters + 4 envelope followers x 1 filter
+const unsigned int kDSPArenaBiquads = 16;
+const unsigned int kDSPArenaDetectors = 4;	///< 4 envelope followers x 1 detector
+const unsigned int kDSPArenaAlignment = 64;	///< cache line size
+
+/**
+\struct DSPStateArena
+\ingroup FX-Objects
+\brief
+Structure-of-arrays storage for the per-sample state of one plugin instance; each row is
+indexed by the slot that a view receives when it binds to the arena. Every row starts on a
+cache line boundary when the arena itself is 64-byte aligned (see DSPStateArenaStorage).
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct DSPStateArena
+{
+	DSPStateArena()
+	{
+		memset(&biquadCoeffs[0][0], 0, sizeof(biquadCoeffs));
+		memset(&biquadStates[0][0], 0, sizeof(biquadStates));
+		memset(&detectorEnvelope[0], 0, sizeof(detectorEnvelope));
+		memset(&detectorAttack[0], 0, sizeof(detectorAttack));
+		memset(&detectorRelease[0], 0, sizeof(detectorRelease));
+	}
+
+	/** hand out the next free biquad slot; returns false when the arena is full */
+	bool allocateBiquad(unsigned int& slot)
+	{
+		if (biquadCount >= kDSPArenaBiquads)
+			return false;
+		slot = biquadCount++;
+		return true;
+	}
+
+	/** hand out the next free detector slot; returns false when the arena is full */
+	bool allocateDetector(unsigned int& slot)
+	{
+		if (detectorCount >= kDSPArenaDetectors)
+			return false;
+		slot = detectorCount++;
+		return true;
+	}
+
+	// --- biquads: [coefficient or state][slot]
+	alignas(kDSPArenaAlignment) double biquadCoeffs[numCoeffs][kDSPArenaBiquads];	///< a0..b2, c0, d0
+	alignas(kDSPArenaAlignment) double biquadStates[numStates][kDSPArenaBiquads];	///< z^-1 registers
+
+	// --- detectors: [slot]
+	alignas(kDSPArenaAlignment) double detectorEnvelope[kDSPArenaDetectors];	///< last envelope
+	double detectorAttack[kDSPArenaDetectors];	///< attack time coefficient
+	double detectorRelease[kDSPArenaDetectors];	///< release time coefficient
+
+	// --- allocation counters (cold)
+	unsigned int biquadCount = 0;
+	unsigned int detectorCount = 0;
+};
+
+/**
+\class DSPStateArenaStorage
+\ingroup FX-Objects
+\brief
+Owns one DSPStateArena placed on a 64-byte boundary inside its own buffer, so the arena can be a
+plain member of the object that uses it (no heap allocation and no reliance on over-aligned new).
+Not copyable: the views hold pointers into it.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class DSPStateArenaStorage
+{
+public:
+	DSPStateArenaStorage()		/* C-TOR */
+	{
+		void* ptr = &buffer[0];
+		size_t space = sizeof(buffer);
+		arena = new (std::align(kDSPArenaAlignment, sizeof(DSPStateArena), ptr, space)) DSPStateArena;
+	}
+	~DSPStateArenaStorage() { arena->~DSPStateArena(); }	/* D-TOR */
+
+	DSPStateArenaStorage(const DSPStateArenaStorage&) = delete;
+	DSPStateArenaStorage& operator=(const DSPStateArenaStorage&) = delete;
+
+	/** the aligned arena */
+	DSPStateArena& get() { return *arena; }
+
+protected:
+	unsigned char buffer[sizeof(DSPStateArena) + kDSPArenaAlignment];	///< raw storage
+	DSPStateArena* arena = nullptr;										///< aligned arena inside buffer
+};
+
+/**
+\class ArenaAudioFilter
+\ingroup FX-Objects
+\brief
+AudioFilter view whose coefficients and z^-1 registers live in a DSPStateArena slot; processes
+with the direct form structure, matching AudioFilter and StaticAudioFilter<> bit for bit.
+
+Must be bound with bindToArena( ) before processing; parameters set before binding are kept and
+cooked when the view binds.
+
+Control I/F:
+- Use AudioFilterParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class ArenaAudioFilter
+{
+public:
+	ArenaAudioFilter() {}		/* C-TOR */
+	~ArenaAudioFilter() {}		/* D-TOR */
+
+	/** claim a slot in the arena and cook the current parameters into it */
+	bool bindToArena(DSPStateArena& _arena)
+	{
+		if (!_arena.allocateBiquad(slot))
+			return false;
+
+		arena = &_arena;
+		calculateFilterCoeffs();
+		return true;
+	}
+
+	/** --- set sample rate and flush the z^-1 registers */
+	inline bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		if (!arena)
+			return false;
+
+		for (unsigned int i = 0; i < numStates; i++)
+			arena->biquadStates[i][slot] = 0.0;
+		return true;
+	}
+
+	/** process input x(n) through the filter: return (dry) + (processed): x(n)*d0 + y(n)*c0 */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	inline double processAudioSample(double xn)
+	{
+		// --- not bound to an arena yet: pass the input through untouched
+		if (!arena)
+			return xn;
+
+		double (&coeff)[numCoeffs][kDSPArenaBiquads] = arena->biquadCoeffs;
+		double (&state)[numStates][kDSPArenaBiquads] = arena->biquadStates;
+
+		// --- direct form: y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
+		double storageComponent = coeff[a1][slot] * state[x_z1][slot] +
+								  coeff[a2][slot] * state[x_z2][slot] -
+								  coeff[b1][slot] * state[y_z1][slot] -
+								  coeff[b2][slot] * state[y_z2][slot];
+
+		double yn = coeff[a0][slot] * xn + storageComponent;
+
+		checkFloatUnderflow(yn);
+
+		state[x_z2][slot] = state[x_z1][slot];
+		state[x_z1][slot] = xn;
+		state[y_z2][slot] = state[y_z1][slot];
+		state[y_z1][slot] = yn;
+
+		return coeff[d0][slot] * xn + coeff[c0][slot] * yn;
+	}
+
+	/** --- sample rate change necessarily requires recalculation */
+	inline void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		calculateFilterCoeffs();
+	}
+
+	/** --- get parameters */
+	AudioFilterParameters getParameters() { return audioFilterParameters; }
+
+	/** --- gather our arena column into a coefficient array (numCoeffs long); false if not bound */
+	bool getCoefficients(double* coeffs)
+	{
+		if (!arena)
+			return false;
+
+		for (unsigned int i = 0; i < numCoeffs; i++)
+			coeffs[i] = arena->biquadCoeffs[i][slot];
+		return true;
+	}
+
+	/** --- set parameters; coefficients are only recalculated when something changed */
+	inline void setParameters(const AudioFilterParameters& parameters)
+	{
+		if (audioFilterParameters.algorithm == parameters.algorithm &&
+			audioFilterParameters.boostCut_dB == parameters.boostCut_dB &&
+			audioFilterParameters.fc == parameters.fc &&
+			audioFilterParameters.Q == parameters.Q)
+			return;
+
+		audioFilterParameters = parameters;
+
+		// --- don't allow 0 or (-) values for Q
+		if (audioFilterParameters.Q <= 0)
+			audioFilterParameters.Q = 0.707;
+
+		calculateFilterCoeffs();
+	}
+
+protected:
+	DSPStateArena* arena = nullptr;				///< arena we are bound to
+	unsigned int slot = 0;						///< our column in the arena
+	AudioFilterParameters audioFilterParameters;///< parameters
+	double sampleRate = 44100.0;				///< current sample rate
+
+	/** --- recalculate coefficients and scatter them into our arena column */
+	bool calculateFilterCoeffs()
+	{
+		if (!arena)
+			return false;
+
+		double coeffArray[numCoeffs] = { 0.0 };
+		if (!calculateAudioFilterCoeffs(audioFilterParameters, sampleRate, coeffArray))
+			return false;
+
+		for (unsigned int i = 0; i < numCoeffs; i++)
+			arena->biquadCoeffs[i][slot] = coeffArray[i];
+		return true;
+	}
+};
+
+/**
+\class ArenaAudioDetector
+\ingroup FX-Objects
+\brief
+AudioDetector view whose envelope register and time constants live in a DSPStateArena slot;
+see AudioDetector for the detection algorithm.
+
+Must be bound with bindToArena( ) before processing.
+
+Control I/F:
+- Use AudioDetectorParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class ArenaAudioDetector
+{
+public:
+	ArenaAudioDetector() {}		/* C-TOR */
+	~ArenaAudioDetector() {}	/* D-TOR */
+
+	/** claim a slot in the arena and cook the current time constants into it */
+	bool bindToArena(DSPStateArena& _arena)
+	{
+		if (!_arena.allocateDetector(slot))
+			return false;
+
+		arena = &_arena;
+		arena->detectorEnvelope[slot] = 0.0;
+		setAttackTime(audioDetectorParameters.attackTime_mSec, true);
+		setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+		return true;
+	}
+
+	/** set sample rate dependent time constants and clear last envelope output value */
+	inline bool reset(double _sampleRate)
+	{
+		setSampleRate(_sampleRate);
+		if (!arena)
+			return false;
+
+		arena->detectorEnvelope[slot] = 0.0;
+		return true;
+	}
+
+	/** detect the envelope; returns dB when detect_dB is set */
+	/**
+	\param xn input
+	\return the detected value
+	*/
+	inline double processAudioSample(double xn)
+	{
+		// --- not bound to an arena yet: nothing detected
+		if (!arena)
+			return 0.0;
+
+		double& lastEnvelope = arena->detectorEnvelope[slot];
+
+		// --- all modes do Full Wave Rectification
+		double input = fabs(xn);
+
+		// --- square it for MS and RMS
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+			audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			input *= input;
+
+		// --- do the detection with attack or release applied
+		double currEnvelope = 0.0;
+		if (input > lastEnvelope)
+			currEnvelope = arena->detectorAttack[slot] * (lastEnvelope - input) + input;
+		else
+			currEnvelope = arena->detectorRelease[slot] * (lastEnvelope - input) + input;
+
+		checkFloatUnderflow(currEnvelope);
+
+		if (audioDetectorParameters.clampToUnityMax)
+			currEnvelope = fmin(currEnvelope, 1.0);
+
+		currEnvelope = fmax(currEnvelope, 0.0);
+
+		// --- store envelope prior to sqrt for RMS version
+		lastEnvelope = currEnvelope;
+
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			currEnvelope = pow(currEnvelope, 0.5);
+
+		if (!audioDetectorParameters.detect_dB)
+			return currEnvelope;
+
+		if (currEnvelope <= 0)
+			return -96.0;
+
+		return raw2dBFast(currEnvelope);
+	}
+
+	/** get parameters */
+	AudioDetectorParameters getParameters() { return audioDetectorParameters; }
+
+	/** set parameters */
+	inline void setParameters(const AudioDetectorParameters& parameters)
+	{
+		audioDetectorParameters = parameters;
+
+		setAttackTime(audioDetectorParameters.attackTime_mSec, true);
+		setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+	}
+
+	/** set sample rate - our time constants depend on it */
+	inline void setSampleRate(double _sampleRate)
+	{
+		if (sampleRate == _sampleRate)
+			return;
+
+		sampleRate = _sampleRate;
+
+		setAttackTime(audioDetectorParameters.attackTime_mSec, true);
+		setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+	}
+
+protected:
+	DSPStateArena* arena = nullptr;						///< arena we are bound to
+	unsigned int slot = 0;								///< our column in the arena
+	AudioDetectorParameters audioDetectorParameters;	///< parameters for object
+	double sampleRate = 44100;							///< stored sample rate
+
+	/** set our attack time coefficient based on time and sample rate */
+	void setAttackTime(double attack_in_ms, bool forceCalc = false)
+	{
+		if (!forceCalc && audioDetectorParameters.attackTime_mSec == attack_in_ms)
+			return;
+
+		audioDetectorParameters.attackTime_mSec = attack_in_ms;
+		if (arena)
+			arena->detectorAttack[slot] = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (attack_in_ms * sampleRate * 0.001));
+	}
+
+	/** set our release time coefficient based on time and sample rate */
+	void setReleaseTime(double release_in_ms, bool forceCalc = false)
+	{
+		if (!forceCalc && audioDetectorParameters.releaseTime_mSec == release_in_ms)
+			return;
+
+		audioDetectorParameters.releaseTime_mSec = release_in_ms;
+		if (arena)
+			arena->detectorRelease[slot] = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (release_in_ms * sampleRate * 0.001));
+	}
+};
+
+#endif
@@ -0,0 +1,156 @@
+#pragma once
+
+#ifndef __FFTWPlanRegistry__
+#define __FFTWPlanRegistry__
+
+#ifdef HAVE_FFTW
+#include <stdint.h>
+#include <stdio.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include "fftw3.h"
+
+/** @file fftwplanregistry.h
+\brief process-wide cache of FFTW plans, shared by every FFT object and planned under one lock
+*/
+
+/**
+\enum fftPlanType
+\ingroup Constants-Enums
+\brief
+The transforms the FFTWPlanRegistry can plan; together with the length this is the registry key.
+
+- kComplexForward, kComplexInverse: c2c (fftw_execute_dft)
+- kRealForward: r2c, length real inputs to length/2 + 1 complex outputs (fftw_execute_dft_r2c)
+- kRealInverse: c2r, the reverse; destroys its input (fftw_execute_dft_c2r)
+*/
+enum class fftPlanType { kComplexForward, kComplexInverse, kRealForward, kRealInverse };
+
+// --- planning rigor; MEASURE plans are slow to make but are saved as wisdom, so only the first load pays
+const unsigned int FFTW_REGISTRY_PLANNER_FLAGS = FFTW_MEASURE;
+
+/**
+\class FFTWPlanRegistry
+\ingroup FFTW-Objects
+\brief
+The FFTWPlanRegistry object owns one FFTW plan per (length, fftPlanType) for the whole plugin module, so many
+instances opening at once share plans instead of each planning their own.
+
+- FFTW's planner (and fftw_destroy_plan) is not thread-safe: every call into it happens under one mutex here;
+  executing a plan is thread-safe, so callers run the shared plans on their own arrays with the new-array API
+  (fftw_execute_dft, fftw_execute_dft_r2c, fftw_execute_dft_c2r), out-of-place, on fftw_malloc'd arrays
+- plans are made on scratch arrays, so measuring never touches a caller's data; they live until the module unloads
+- setWisdomFile( ) imports saved wisdom once and every new plan re-exports it, so later loads skip the measuring
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class FFTWPlanRegistry
+{
+public:
+	/** the module's registry */
+	static FFTWPlanRegistry& getInstance()
+	{
+		static FFTWPlanRegistry registry;
+		return registry;
+	}
+
+	/** get (planning it on first use) the shared plan for a transform; never destroy it */
+	/**
+	\param length the FFT length
+	\param type the transform
+	\return the plan, or nullptr if FFTW could not make one
+	*/
+	fftw_plan getPlan(unsigned int length, fftPlanType type)
+	{
+		std::lock_guard<std::mutex> lock(plannerMutex);
+
+		uint64_t key = ((uint64_t)length << 8) | (uint64_t)type;
+		std::map<uint64_t, fftw_plan>::iterator it = plans.find(key);
+		if (it != plans.end())
+			return it->second;
+
+		fftw_plan plan = makePlan(length, type);
+		if (plan)
+		{
+			plans[key] = plan;
+			saveWisdom();
+		}
+		return plan;
+	}
+
+	/** name the wisdom file and import it; the first call wins, later calls (other instances) are ignored */
+	/**
+	\param path the wisdom file
+	\return true if wisdom was imported
+	*/
+	bool setWisdomFile(const char* path)
+	{
+		std::lock_guard<std::mutex> lock(plannerMutex);
+		if (!path || !wisdomPath.empty())
+			return false;
+
+		wisdomPath = path;
+		return fftw_import_wisdom_from_filename(wisdomPath.c_str()) != 0;
+	}
+
+private:
+	FFTWPlanRegistry() {}
+	~FFTWPlanRegistry()
+	{
+		std::lock_guard<std::mutex> lock(plannerMutex);
+		for (std::map<uint64_t, fftw_plan>::iterator it = plans.begin(); it != plans.end(); ++it)
+			fftw_destroy_plan(it->second);
+		plans.clear();
+	}
+
+	/** plan on scratch arrays; call with plannerMutex held */
+	fftw_plan makePlan(unsigned int length, fftPlanType type)
+	{
+		double* realData = (double*)fftw_malloc(sizeof(double) * length);
+		fftw_complex* complexIn = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * length);
+		fftw_complex* complexOut = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * length);
+
+		fftw_plan plan = nullptr;
+		if (realData && complexIn && complexOut)
+		{
+			switch (type)
+			{
+			case fftPlanType::kComplexForward:
+				plan = fftw_plan_dft_1d(length, complexIn, complexOut, FFTW_FORWARD, FFTW_REGISTRY_PLANNER_FLAGS);
+				break;
+			case fftPlanType::kComplexInverse:
+				plan = fftw_plan_dft_1d(length, complexIn, complexOut, FFTW_BACKWARD, FFTW_REGISTRY_PLANNER_FLAGS);
+				break;
+			case fftPlanType::kRealForward:
+				plan = fftw_plan_dft_r2c_1d(length, realData, complexOut, FFTW_REGISTRY_PLANNER_FLAGS);
+				break;
+			case fftPlanType::kRealInverse:
+				plan = fftw_plan_dft_c2r_1d(length, complexIn, realData, FFTW_REGISTRY_PLANNER_FLAGS);
+				break;
+			}
+		}
+
+		fftw_free(realData);
+		fftw_free(complexIn);
+		fftw_free(complexOut);
+		return plan;
+	}
+
+	/** export all wisdom so far; call with plannerMutex held; a read-only install just keeps planning */
+	void saveWisdom()
+	{
+		if (!wisdomPath.empty())
+			fftw_export_wisdom_to_filename(wisdomPath.c_str());
+	}
+
+	std::mutex plannerMutex;					///< serializes every planner call
+	std::map<uint64_t, fftw_plan> plans;		///< (length << 8 | type) -> plan
+	std::string wisdomPath;						///< wisdom file; empty = no persistence
+};
+
+#endif // HAVE_FFTW
+
+#endif
@@ -0,0 +1,334 @@
+#pragma once
+
+#ifndef __FilterCurve__
+#define __FilterCurve__
+
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+/** @file filtercurve.h
+\brief biquad coefficient snapshots of the band splitter and the ModFilter, and the GUI-side evaluation of their
+frequency response for the FilterCurveView; no fxobjects.h dependency so the GUI can include it on its own
+*/
+
+// --- coefficients per biquad, in the filterCoeff order of fxobjects.h: a0, a1, a2, b1, b2, c0, d0
+const unsigned int FILTER_CURVE_NUM_COEFFS = 7;
+const unsigned int FILTER_CURVE_NUM_SPLITS = 3;	///< low, mid and high crossover
+const unsigned int FILTER_CURVE_NUM_BANDS = 4;	///< LPF, low band, high band, HPF
+
+// --- floor for the dB curves (-120dB)
+const double FILTER_CURVE_MIN_MAGNITUDE = 1.0e-6;
+
+/**
+\struct FilterCurveSnapshot
+\ingroup FX-Objects
+\brief
+Everything needed to draw the linear response of the band splitter and ModFilter: their biquad coefficients and the
+cooked (target) gains around them. The audio thread fills one at the end of a block and publishes it only if it
+differs from the last one; the saturation stages are nonlinear and are not part of the curve.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct FilterCurveSnapshot
+{
+	FilterCurveSnapshot() {}
+
+	/** \return true if both snapshots describe the same curve */
+	bool operator==(const FilterCurveSnapshot& other) const
+	{
+		return sampleRate == other.sampleRate &&
+			memcmp(splitLowpass, other.splitLowpass, sizeof(splitLowpass)) == 0 &&
+			memcmp(splitHighpass, other.splitHighpass, sizeof(splitHighpass)) == 0 &&
+			memcmp(bandGain, other.bandGain, sizeof(bandGain)) == 0 &&
+			splitterBoost == other.splitterBoost &&
+			splitterDryGain == other.splitterDryGain &&
+			memcmp(modFilter, other.modFilter, sizeof(modFilter)) == 0 &&
+			memcmp(modFilterDouble, other.modFilterDouble, sizeof(modFilterDouble)) == 0 &&
+			modFilterGain == other.modFilterGain &&
+			modFilterDryGain == other.modFilterDryGain &&
+			splitterEnabled == other.splitterEnabled &&
+			splitView == other.splitView &&
+			modFilterEnabled == other.modFilterEnabled &&
+			modFilterDoubled == other.modFilterDoubled &&
+			signalFlow == other.signalFlow;
+	}
+
+	/** \return true if the snapshots differ */
+	bool operator!=(const FilterCurveSnapshot& other) const { return !(*this == other); }
+
+	double sampleRate = 0.0;														///< 0 = not yet reset, nothing to draw
+	double splitLowpass[FILTER_CURVE_NUM_SPLITS][FILTER_CURVE_NUM_COEFFS] = { { 0.0 } };	///< LR low pass of each split
+	double splitHighpass[FILTER_CURVE_NUM_SPLITS][FILTER_CURVE_NUM_COEFFS] = { { 0.0 } };	///< LR high pass of each split (inverted by the bank)
+	double bandGain[FILTER_CURVE_NUM_BANDS] = { 0.0 };							///< linear band volumes
+	double splitterBoost = 1.0;													///< linear, applied to the band sum
+	double splitterDryGain = 0.0;												///< linear splitter dry volume
+	double modFilter[FILTER_CURVE_NUM_COEFFS] = { 0.0 };						///< current (modulated) ModFilter biquad
+	double modFilterDouble[FILTER_CURVE_NUM_COEFFS] = { 0.0 };					///< the doubled filter, when modFilterDoubled
+	double modFilterGain = 1.0;													///< linear boost applied to the filter output
+	double modFilterDryGain = 0.0;												///< linear ModFilter dry volume
+	uint32_t splitterEnabled = 0;		///< 0 = the splitter passes its input through
+	uint32_t splitView = 0;				///< (uint32_t)splitSelection: 0 = all bands, 1..4 = one band soloed
+	uint32_t modFilterEnabled = 0;		///< 0 = the ModFilter passes its input through (plus dry)
+	uint32_t modFilterDoubled = 0;		///< 1 = the doubled filter is added to the output
+	uint32_t signalFlow = 0;			///< 0 = splitter -> filter, 1 = filter -> splitter, 2 = parallel (0.5 each)
+};
+
+/**
+\class FilterCurveEvaluator
+\ingroup FX-Objects
+\brief
+The FilterCurveEvaluator object evaluates a FilterCurveSnapshot on a log-spaced frequency grid, on the GUI thread.
+
+- each biquad is evaluated as a complex H(e^jw) = c0 * (a0 + a1 z^-1 + a2 z^-2) / (1 + b1 z^-1 + b2 z^-2) + d0; the
+  bands are summed with their phase, as the splitter sums them, so the crossover regions come out right
+- cos/sin of w and 2w are computed once per grid and sample rate; every evaluation pass is a branch-free loop over
+  structure-of-arrays buffers that the compiler can vectorize
+- setFrequencyRange( ) allocates; evaluate( ) does not
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class FilterCurveEvaluator
+{
+public:
+	FilterCurveEvaluator(void) {}	/* C-TOR */
+	~FilterCurveEvaluator(void) {}	/* D-TOR */
+
+	/** set up the log-spaced frequency grid
+	\param _numPoints number of points, e.g. one per few pixels of the view width
+	\param minFrequency lowest frequency in Hz
+	\param maxFrequency highest frequency in Hz
+	*/
+	void setFrequencyRange(uint32_t _numPoints, double minFrequency, double maxFrequency)
+	{
+		numPoints = _numPoints;
+		frequencies.assign(numPoints, 0.0);
+		double ratio = numPoints > 1 ? pow(maxFrequency / minFrequency, 1.0 / (numPoints - 1)) : 1.0;
+		for (uint32_t k = 0; k < numPoints; k++)
+			frequencies[k] = minFrequency * pow(ratio, (double)k);
+
+		cosW.assign(numPoints, 0.0);
+		sinW.assign(numPoints, 0.0);
+		cos2W.assign(numPoints, 0.0);
+		sin2W.assign(numPoints, 0.0);
+		workspace.assign(kNumWorkArrays * numPoints, 0.0);
+		gridSampleRate = 0.0;
+	}
+
+	/** \return the number of points on the grid */
+	uint32_t getNumPoints() { return numPoints; }
+
+	/** \return the grid frequencies in Hz */
+	const double* getFrequencies() { return frequencies.data(); }
+
+	/** evaluate all curves for a snapshot
+	\param snapshot the coefficients and gains
+	\return false if there is nothing to draw (no grid, or the plugin has not been reset yet)
+	*/
+	bool evaluate(const FilterCurveSnapshot& snapshot)
+	{
+		if (numPoints == 0 || snapshot.sampleRate <= 0.0)
+			return false;
+
+		if (snapshot.sampleRate != gridSampleRate)
+			buildGrid(snapshot.sampleRate);
+
+		double* lpRe = getWorkArray(kLowpassRe);
+		double* lpIm = getWorkArray(kLowpassIm);
+		double* hpRe = getWorkArray(kHighpassRe);
+		double* hpIm = getWorkArray(kHighpassIm);
+		double* chainRe = getWorkArray(kChainRe);
+		double* chainIm = getWorkArray(kChainIm);
+		double* dryRe = getWorkArray(kDryRe);
+		double* dryIm = getWorkArray(kDryIm);
+		double* splitRe = getWorkArray(kSplitterRe);
+		double* splitIm = getWorkArray(kSplitterIm);
+		double* modRe = getWorkArray(kModFilterRe);
+		double* modIm = getWorkArray(kModFilterIm);
+
+		// --- splitter: each split's LP takes one band, its (inverted) HP feeds the next split
+		setConstant(chainRe, chainIm, 1.0);
+		setConstant(dryRe, dryIm, 0.0);
+		for (uint32_t s = 0; s < FILTER_CURVE_NUM_SPLITS; s++)
+		{
+			evaluateBiquad(snapshot.splitLowpass[s], lpRe, lpIm);
+			evaluateBiquad(snapshot.splitHighpass[s], hpRe, hpIm);
+
+			double* bandRe = getWorkArray(kBandRe + 2 * s);
+			double* bandIm = getWorkArray(kBandIm + 2 * s);
+			for (uint32_t k = 0; k < numPoints; k++)
+			{
+				bandRe[k] = chainRe[k] * lpRe[k] - chainIm[k] * lpIm[k];
+				bandIm[k] = chainRe[k] * lpIm[k] + chainIm[k] * lpRe[k];
+				double nextRe = -(chainRe[k] * hpRe[k] - chainIm[k] * hpIm[k]);
+				double nextIm = -(chainRe[k] * hpIm[k] + chainIm[k] * hpRe[k]);
+				chainRe[k] = nextRe;
+				chainIm[k] = nextIm;
+
+				// --- the splitter's dry path sums both outputs of every bank
+				dryRe[k] += bandRe[k] + nextRe;
+				dryIm[k] += bandIm[k] + nextIm;
+			}
+		}
+
+		// --- the last HP output is the HPF band
+		memcpy(getWorkArray(kBandRe + 2 * (FILTER_CURVE_NUM_BANDS - 1)), chainRe, numPoints * sizeof(double));
+		memcpy(getWorkArray(kBandIm + 2 * (FILTER_CURVE_NUM_BANDS - 1)), chainIm, numPoints * sizeof(double));
+
+		for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
+			toDecibels(getWorkArray(kBandRe + 2 * b), getWorkArray(kBandIm + 2 * b), snapshot.bandGain[b], getCurveArray(kBandCurve + b));
+
+		if (!snapshot.splitterEnabled)
+			setConstant(splitRe, splitIm, 1.0);
+		else if (snapshot.splitView == 0)
+		{
+			setConstant(splitRe, splitIm, 0.0);
+			for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
+				accumulate(getWorkArray(kBandRe + 2 * b), getWorkArray(kBandIm + 2 * b), snapshot.bandGain[b] * snapshot.splitterBoost, splitRe, splitIm);
+			accumulate(dryRe, dryIm, snapshot.splitterDryGain, splitRe, splitIm);
+		}
+		else
+		{
+			uint32_t b = snapshot.splitView <= FILTER_CURVE_NUM_BANDS ? snapshot.splitView - 1 : 0;
+			setConstant(splitRe, splitIm, 0.0);
+			accumulate(getWorkArray(kBandRe + 2 * b), getWorkArray(kBandIm + 2 * b), snapshot.bandGain[b], splitRe, splitIm);
+		}
+
+		// --- ModFilter: boosted filter (plus the doubled one) and its dry path
+		evaluateBiquad(snapshot.modFilter, lpRe, lpIm);
+		toDecibels(lpRe, lpIm, snapshot.modFilterGain, getCurveArray(kModFilterCurve));
+
+		setConstant(modRe, modIm, snapshot.modFilterEnabled ? 0.0 : 1.0);
+		if (snapshot.modFilterEnabled)
+		{
+			accumulate(lpRe, lpIm, snapshot.modFilterGain, modRe, modIm);
+			if (snapshot.modFilterDoubled)
+			{
+				evaluateBiquad(snapshot.modFilterDouble, hpRe, hpIm);
+				accumulate(hpRe, hpIm, 1.0, modRe, modIm);
+			}
+		}
+		for (uint32_t k = 0; k < numPoints; k++)
+			modRe[k] += snapshot.modFilterDryGain;
+
+		// --- the signal flow: series in either order, or a 0.5/0.5 parallel mix
+		if (snapshot.signalFlow == 2)
+		{
+			for (uint32_t k = 0; k < numPoints; k++)
+			{
+				chainRe[k] = 0.5 * (splitRe[k] + modRe[k]);
+				chainIm[k] = 0.5 * (splitIm[k] + modIm[k]);
+			}
+		}
+		else
+		{
+			for (uint32_t k = 0; k < numPoints; k++)
+			{
+				chainRe[k] = splitRe[k] * modRe[k] - splitIm[k] * modIm[k];
+				chainIm[k] = splitRe[k] * modIm[k] + splitIm[k] * modRe[k];
+			}
+		}
+		toDecibels(chainRe, chainIm, 1.0, getCurveArray(kTotalCurve));
+		return true;
+	}
+
+	/** \return a band's response in dB, including its volume; band 0 = LPF ... 3 = HPF */
+	const double* getBandCurve(uint32_t band) { return getCurveArray(kBandCurve + (band < FILTER_CURVE_NUM_BANDS ? band : 0)); }
+
+	/** \return the ModFilter's response in dB, including its boost, without its dry path */
+	const double* getModFilterCurve() { return getCurveArray(kModFilterCurve); }
+
+	/** \return the response of the whole linear path in dB */
+	const double* getTotalCurve() { return getCurveArray(kTotalCurve); }
+
+protected:
+	// --- workspace layout: complex scratch arrays, then the dB curves
+	enum { kLowpassRe, kLowpassIm, kHighpassRe, kHighpassIm, kChainRe, kChainIm, kDryRe, kDryIm,
+		   kSplitterRe, kSplitterIm, kModFilterRe, kModFilterIm,
+		   kBandRe, kBandIm, kNumComplexArrays = kBandIm + 2 * FILTER_CURVE_NUM_BANDS - 1 };
+	enum { kBandCurve, kModFilterCurve = kBandCurve + FILTER_CURVE_NUM_BANDS, kTotalCurve, kNumCurves };
+	enum { kNumWorkArrays = kNumComplexArrays + kNumCurves };
+
+	inline double* getWorkArray(uint32_t index) { return workspace.data() + index * numPoints; }
+	inline double* getCurveArray(uint32_t index) { return getWorkArray(kNumComplexArrays + index); }
+
+	/** precompute cos/sin of w and 2w for the grid at a sample rate */
+	void buildGrid(double sampleRate)
+	{
+		const double twoPi = 2.0 * 3.14159265358979323846;
+		for (uint32_t k = 0; k < numPoints; k++)
+		{
+			double w = twoPi * frequencies[k] / sampleRate;
+			cosW[k] = cos(w);
+			sinW[k] = sin(w);
+			cos2W[k] = cos(2.0 * w);
+			sin2W[k] = sin(2.0 * w);
+		}
+		gridSampleRate = sampleRate;
+	}
+
+	/** H(e^jw) of one biquad at every grid point */
+	void evaluateBiquad(const double* coeffs, double* re, double* im)
+	{
+		const double a0 = coeffs[0], a1 = coeffs[1], a2 = coeffs[2], b1 = coeffs[3], b2 = coeffs[4];
+		const double c0 = coeffs[5], d0 = coeffs[6];
+		for (uint32_t k = 0; k < numPoints; k++)
+		{
+			// --- z^-1 = cos(w) - jsin(w), z^-2 = cos(2w) - jsin(2w)
+			double numRe = a0 + a1 * cosW[k] + a2 * cos2W[k];
+			double numIm = -(a1 * sinW[k] + a2 * sin2W[k]);
+			double denRe = 1.0 + b1 * cosW[k] + b2 * cos2W[k];
+			double denIm = -(b1 * sinW[k] + b2 * sin2W[k]);
+			double scale = c0 / (denRe * denRe + denIm * denIm);
+			re[k] = (numRe * denRe + numIm * denIm) * scale + d0;
+			im[k] = (numIm * denRe - numRe * denIm) * scale;
+		}
+	}
+
+	inline void setConstant(double* re, double* im, double value)
+	{
+		for (uint32_t k = 0; k < numPoints; k++)
+		{
+			re[k] = value;
+			im[k] = 0.0;
+		}
+	}
+
+	/** sum += gain * x */
+	inline void accumulate(const double* re, const double* im, double gain, double* sumRe, double* sumIm)
+	{
+		for (uint32_t k = 0; k < numPoints; k++)
+		{
+			sumRe[k] += gain * re[k];
+			sumIm[k] += gain * im[k];
+		}
+	}
+
+	/** 20log10(gain * |x|), floored at FILTER_CURVE_MIN_MAGNITUDE */
+	inline void toDecibels(const double* re, const double* im, double gain, double* dB)
+	{
+		const double minPower = FILTER_CURVE_MIN_MAGNITUDE * FILTER_CURVE_MIN_MAGNITUDE;
+		const double gainSquared = gain * gain;
+		for (uint32_t k = 0; k < numPoints; k++)
+		{
+			double power = gainSquared * (re[k] * re[k] + im[k] * im[k]);
+			dB[k] = 10.0 * log10(power > minPower ? power : minPower);
+		}
+	}
+
+	uint32_t numPoints = 0;				///< grid size
+	double gridSampleRate = 0.0;		///< sample rate the cos/sin tables were built for
+	std::vector<double> frequencies;	///< grid frequencies in Hz
+	std::vector<double> cosW;			///< cos(w) per point
+	std::vector<double> sinW;			///< sin(w) per point
+	std::vector<double> cos2W;			///< cos(2w) per point
+	std::vector<double> sin2W;			///< sin(2w) per point
+	std::vector<double> workspace;		///< kNumWorkArrays arrays of numPoints
+};
+
+#endif
@@ -4,6 +4,11 @@
 #define __FourWayBandSplitter__
 
 #include "fxobjects.h"
+#include "staticfxobjects.h"
+#include "dspstatearena.h"
+#include "gainramp.h"
+#include "filtercurve.h"
+#include "blockmeter.h"
 
 
 // TESTING
@@ -26,6 +31,7 @@ enum class splitSelection {kSplitter, kLPF, kLowBand, kHighBand, kHPF};
 struct FourWayBandSplitterParameters
 {
 	FourWayBandSplitterParameters() {}
+	FourWayBandSplitterParameters(const FourWayBandSplitterParameters&) = default;
 
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	FourWayBandSplitterParameters& operator=(const FourWayBandSplitterParameters& params)	// need this override for collections to work
@@ -120,6 +126,13 @@ public:
 		// --- store the sample rate
 		sampleRate = _sampleRate;
 
+		// --- stand-alone use: no owner supplied an arena, so use our own
+		if (!arenaBound)
+		{
+			ownedArena.reset(new DSPStateArenaStorage);
+			bindToArena(ownedArena->get());
+		}
+
 		// --- do any other per-audio-run inits here
 		splitterFilters[0].reset(sampleRate);
 		splitterFilters[1].reset(sampleRate);
@@ -128,9 +141,42 @@ public:
 		splitterFilters[4].reset(sampleRate);
 		splitterFilters[5].reset(sampleRate);
 
+		for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
+			bandMeters[b].reset(sampleRate);
+
+		// --- the first gains after a reset are applied without a ramp
+		snapGains = true;
+
 		return true;
 	}
 
+	/** set the length of the gain ramps; the owner calls this once per block with the block size */
+	/**
+	\param samples ramp length in samples
+	*/
+	void setGainRampLength(uint32_t samples)
+	{
+		lpfVolumeRamp.setRampLength(samples);
+		lowbandVolumeRamp.setRampLength(samples);
+		highbandVolumeRamp.setRampLength(samples);
+		hpfVolumeRamp.setRampLength(samples);
+		dryVolumeRamp.setRampLength(samples);
+		boostRamp.setRampLength(samples);
+	}
+
+	/** bind the filter banks to a state arena; the owner (e.g. PluginCore) calls this before reset( ) */
+	/**
+	\param arena the per-instance arena that holds the hot filter state
+	\return true if all filters found a slot
+	*/
+	bool bindToArena(DSPStateArena& arena)
+	{
+		arenaBound = true;
+		for (int i = 0; i < 6; i++)
+			arenaBound = splitterFilters[i].bindToArena(arena) && arenaBound;
+		return arenaBound;
+	}
+
 	/** process MONO input */
 	/**
 	\param xn input
@@ -141,15 +187,23 @@ public:
 		// --- the output variable
 		double ynL = 0.0;
 
+		// --- one ramp step per sample
+		double lpfGain = lpfVolumeRamp.getNextGain();
+		double lowbandGain = lowbandVolumeRamp.getNextGain();
+		double highbandGain = highbandVolumeRamp.getNextGain();
+		double hpfGain = hpfVolumeRamp.getNextGain();
+		dryVolumeRamp.getNextGain();
+		boostRamp.getNextGain();
+
 		// --- do your DSP magic here to create yn
 		FilterBankOutput lowSplit_Left = splitterFilters[0].processFilterBank(xn);
 		FilterBankOutput midSplit_Left = splitterFilters[2].processFilterBank(xn);
 		FilterBankOutput highSplit_Left = splitterFilters[4].processFilterBank(xn);
 
-		double lpf_Left = lowSplit_Left.LFOut * lpfVolume_cooked;
-		double lowBand_Left = midSplit_Left.LFOut * lowbandVolume_cooked;
-		double highBand_Left = highSplit_Left.LFOut * highbandVolume_cooked;
-		double hpf_Left = highSplit_Left.HFOut * hpfVolume_cooked;
+		double lpf_Left = lowSplit_Left.LFOut * lpfGain;
+		double lowBand_Left = midSplit_Left.LFOut * lowbandGain;
+		double highBand_Left = highSplit_Left.LFOut * highbandGain;
+		double hpf_Left = highSplit_Left.HFOut * hpfGain;
 
 		if (parameters.splitView == splitSelection::kSplitter)
 			ynL = lpf_Left + lowBand_Left + highBand_Left + hpf_Left;
@@ -175,12 +229,78 @@ public:
 		uint32_t inputChannels,
 		uint32_t outputChannels)
 	{
+		return processFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+	}
+
+	/** process a 64-bit audio frame; identical DSP, with no narrowing to float between stages */
+	virtual bool processAudioFrame64(const double* inputFrame,
+		double* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		return processFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+	}
+
+	/** process a block of interleaved frames: one virtual call, processFrame( ) inlined in the loop */
+	virtual bool processAudioFrames(const float* input,
+		float* output,
+		uint32_t numFrames,
+		uint32_t frameStride,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		return processFrames(input, output, numFrames, frameStride, inputChannels, outputChannels);
+	}
+
+	/** process a block of interleaved 64-bit frames */
+	virtual bool processAudioFrames64(const double* input,
+		double* output,
+		uint32_t numFrames,
+		uint32_t frameStride,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		return processFrames(input, output, numFrames, frameStride, inputChannels, outputChannels);
+	}
+
+	/** shared body of the float and double processAudioFrames( ) versions */
+	template <typename SampleType>
+	bool processFrames(const SampleType* input,
+		SampleType* output,
+		uint32_t numFrames,
+		uint32_t frameStride,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
+		for (uint32_t n = 0; n < numFrames; n++)
+		{
+			if (!processFrame(input + n*frameStride, output + n*frameStride, inputChannels, outputChannels))
+				return false; // NOT handled (channel format, same for every frame)
+		}
+		return true;
+	}
+
+	/** shared body of the float and double processAudioFrame( ) versions; the DSP runs in double either way */
+	template <typename SampleType>
+	bool processFrame(const SampleType* inputFrame,
+		SampleType* outputFrame,
+		uint32_t inputChannels,
+		uint32_t outputChannels)
+	{
 
 		double xnL = inputFrame[0];
 		double xnR = inputFrame[1];
 		double ynL = xnL;
 		double ynR = xnR;
 
+		// --- one ramp step per frame, whether or not the splitter is enabled
+		double lpfGain = lpfVolumeRamp.getNextGain();
+		double lowbandGain = lowbandVolumeRamp.getNextGain();
+		double highbandGain = highbandVolumeRamp.getNextGain();
+		double hpfGain = hpfVolumeRamp.getNextGain();
+		double dryGain = dryVolumeRamp.getNextGain();
+		double boostGain = boostRamp.getNextGain();
+
 		if (parameters.enableSplitter)
 		{
 			// --- Filter Bank Outputs
@@ -196,16 +316,16 @@ public:
 
 			// --- Channel Bands
 			// Left
-			double lpf_Left = lowSplit_Left.LFOut * lpfVolume_cooked;
-			double lowBand_Left = midSplit_Left.LFOut * lowbandVolume_cooked;
-			double highBand_Left = highSplit_Left.LFOut * highbandVolume_cooked;
-			double hpf_Left = highSplit_Left.HFOut * hpfVolume_cooked;
+			double lpf_Left = lowSplit_Left.LFOut * lpfGain;
+			double lowBand_Left = midSplit_Left.LFOut * lowbandGain;
+			double highBand_Left = highSplit_Left.LFOut * highbandGain;
+			double hpf_Left = highSplit_Left.HFOut * hpfGain;
 
 			// Right
-			double lpf_Right = lowSplit_Right.LFOut * lpfVolume_cooked;
-			double lowBand_Right = midSplit_Right.LFOut * lowbandVolume_cooked;
-			double highBand_Right = highSplit_Right.LFOut * highbandVolume_cooked;
-			double hpf_Right = highSplit_Right.HFOut * hpfVolume_cooked;
+			double lpf_Right = lowSplit_Right.LFOut * lpfGain;
+			double lowBand_Right = midSplit_Right.LFOut * lowbandGain;
+			double highBand_Right = highSplit_Right.LFOut * highbandGain;
+			double hpf_Right = highSplit_Right.HFOut * hpfGain;
 
 
 			// --- Saturation
@@ -229,6 +349,13 @@ public:
 				hpf_Left = tanh(hpf_Left * hpfK) / tanh(hpfK);
 				hpf_Right = tanh(hpf_Right * hpfK) / tanh(hpfK);
 			}
+
+			// --- metering taps; reduced once per block in updateMeters( )
+			double rightTap = inputChannels == 1 ? 0.0 : 1.0;
+			bandMeters[0].tap(lpf_Left, lpf_Right * rightTap);
+			bandMeters[1].tap(lowBand_Left, lowBand_Right * rightTap);
+			bandMeters[2].tap(highBand_Left, highBand_Right * rightTap);
+			bandMeters[3].tap(hpf_Left, hpf_Right * rightTap);
 				
 			
 
@@ -236,19 +363,19 @@ public:
 			double dryInput_Left = (lowSplit_Left.LFOut + lowSplit_Left.HFOut
 									+ midSplit_Left.LFOut + midSplit_Left.HFOut 
 									+ highSplit_Left.LFOut + highSplit_Left.HFOut)
-									* dryVolume_cooked;
+									* dryGain;
 
 			double dryInput_Right = (lowSplit_Right.LFOut + lowSplit_Right.HFOut
 									+ midSplit_Right.LFOut + midSplit_Right.HFOut
 									+ highSplit_Right.LFOut + highSplit_Right.HFOut)
-									* dryVolume_cooked;
+									* dryGain;
 
 
 			// --- Channel Split Output
 			if (parameters.splitView == splitSelection::kSplitter)
 			{
-				ynL = (lpf_Left + lowBand_Left + highBand_Left + hpf_Left) * boostCooked + dryInput_Left;
-				ynR = (lpf_Right + lowBand_Right + highBand_Right + hpf_Right) * boostCooked + dryInput_Right;
+				ynL = (lpf_Left + lowBand_Left + highBand_Left + hpf_Left) * boostGain + dryInput_Left;
+				ynR = (lpf_Right + lowBand_Right + highBand_Right + hpf_Right) * boostGain + dryInput_Right;
 			}
 			else if (parameters.splitView == splitSelection::kLPF)
 			{
@@ -317,6 +444,45 @@ public:
 		return parameters;
 	}
 
+	/** reduce the block's band taps into the band meters; the owner calls this after each block */
+	/**
+	\param numFrames frames in the block
+	\param numChannels 1 if the block ran mono, otherwise 2
+	*/
+	void updateMeters(uint32_t numFrames, uint32_t numChannels)
+	{
+		for (uint32_t b = 0; b < FILTER_CURVE_NUM_BANDS; b++)
+			bandMeters[b].endBlock(numFrames, numChannels);
+	}
+
+	/** \return a band's held peak, linear; band 0 = LPF ... 3 = HPF */
+	float getBandPeak(uint32_t band) { return band < FILTER_CURVE_NUM_BANDS ? bandMeters[band].getPeak() : 0.f; }
+
+	/** \return a band's RMS level, linear; band 0 = LPF ... 3 = HPF */
+	float getBandRMS(uint32_t band) { return band < FILTER_CURVE_NUM_BANDS ? bandMeters[band].getRMS() : 0.f; }
+
+	/** fill in the splitter's part of a filter curve snapshot: crossover coefficients and cooked gains */
+	/**
+	\param snapshot the snapshot to fill; the other fields are left alone
+	*/
+	void getFilterCurve(FilterCurveSnapshot& snapshot)
+	{
+		static_assert(numCoeffs == FILTER_CURVE_NUM_COEFFS, "FilterCurveSnapshot must match filterCoeff");
+
+		// --- left and right banks are identical; the left ones (even indexes) stand for both
+		for (uint32_t s = 0; s < FILTER_CURVE_NUM_SPLITS; s++)
+			splitterFilters[2 * s].getCoefficients(snapshot.splitLowpass[s], snapshot.splitHighpass[s]);
+
+		snapshot.bandGain[0] = lpfVolumeRamp.getTargetGain();
+		snapshot.bandGain[1] = lowbandVolumeRamp.getTargetGain();
+		snapshot.bandGain[2] = highbandVolumeRamp.getTargetGain();
+		snapshot.bandGain[3] = hpfVolumeRamp.getTargetGain();
+		snapshot.splitterBoost = boostRamp.getTargetGain();
+		snapshot.splitterDryGain = dryVolumeRamp.getTargetGain();
+		snapshot.splitterEnabled = parameters.enableSplitter ? 1 : 0;
+		snapshot.splitView = (uint32_t)parameters.splitView;
+	}
+
 	/** set parameters: note use of custom structure for passing param data */
 	/**
 	\param FourWayBandSplitterParameters custom data structure
@@ -327,26 +493,33 @@ public:
 		//     and copy the variables one at a time, or you may test
 		//     to see if cook-able variables have changed; if not, then
 		//     do not re-cook them as it just wastes CPU
+		bool gainsChanged = snapGains ||
+			params.lpfVolume != parameters.lpfVolume ||
+			params.lowbandVolume != parameters.lowbandVolume ||
+			params.highbandVolume != parameters.highbandVolume ||
+			params.hpfVolume != parameters.hpfVolume ||
+			params.dryVolume != parameters.dryVolume ||
+			params.splitterBoost != parameters.splitterBoost;
+
 		parameters = params;
 
-		
+		// --- cook band volumes; the ramps glide to the new gains
+		if (gainsChanged)
+		{
+			setGain(lpfVolumeRamp, dB2Raw(parameters.lpfVolume));
+			setGain(lowbandVolumeRamp, dB2Raw(parameters.lowbandVolume));
+			setGain(highbandVolumeRamp, dB2Raw(parameters.highbandVolume));
+			setGain(hpfVolumeRamp, dB2Raw(parameters.hpfVolume));
 
-		// --- cook band volumes
-		lpfVolume_cooked = pow(10, parameters.lpfVolume / 20);
-		lowbandVolume_cooked = pow(10, parameters.lowbandVolume / 20);
-		highbandVolume_cooked = pow(10, parameters.highbandVolume / 20);
-		hpfVolume_cooked = pow(10, parameters.hpfVolume / 20);
+			setGain(boostRamp, dB2Raw(parameters.splitterBoost));
 
-		boostCooked = pow(10, parameters.splitterBoost / 20);
+			// --- set range of dry volume
+			if (parameters.dryVolume <= -15.0)
+				setGain(dryVolumeRamp, 0.0);
+			else
+				setGain(dryVolumeRamp, dB2Raw(parameters.dryVolume));
 
-		// --- set range of dry volume
-		if (parameters.dryVolume <= -15.0)
-		{
-			dryVolume_cooked = 0.0;
-		}
-		else
-		{
-			dryVolume_cooked = pow(10, parameters.dryVolume / 20);
+			snapGains = false;
 		}
 
 		// --- Cook Saturation
@@ -389,22 +562,36 @@ public:
 
 
 private:
+	/** ramp to a cooked gain, or jump to it on the first update after reset( ) */
+	void setGain(GainRamp& ramp, double gain)
+	{
+		if (snapGains)
+			ramp.snapToGain(gain);
+		else
+			ramp.setTargetGain(gain);
+	}
+
 	FourWayBandSplitterParameters parameters; ///< object parameters
 
-	LRFilterBank splitterFilters[6];
+	StaticLRFilterBank<ArenaAudioFilter> splitterFilters[6]; ///< hot state lives in the bound DSPStateArena
+	bool arenaBound = false;								///< true once bindToArena( ) succeeded
+	std::unique_ptr<DSPStateArenaStorage> ownedArena;		///< only for stand-alone use
 
-	double lpfVolume_cooked;
-	double lowbandVolume_cooked;
-	double highbandVolume_cooked;
-	double hpfVolume_cooked;
-	double dryVolume_cooked;
+	// --- cooked (linear) gains, ramped over one block
+	GainRamp lpfVolumeRamp;
+	GainRamp lowbandVolumeRamp;
+	GainRamp highbandVolumeRamp;
+	GainRamp hpfVolumeRamp;
+	GainRamp dryVolumeRamp;
+	GainRamp boostRamp;
+	bool snapGains = true;	///< next gain update skips the ramp (set by reset( ))
 
 	double lpfK = 1.0;
 	double lowbandK = 1.0;
 	double highbandK = 1.0;
 	double hpfK = 1.0;
 
-	double boostCooked = 0.0;
+	BlockMeter bandMeters[FILTER_CURVE_NUM_BANDS];	///< band output levels (after volume and saturation)
 
 	// --- local variables used by this object
 	double sampleRate = 0.0;	///< sample rate
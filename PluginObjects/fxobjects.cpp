@@ -126,8 +126,16 @@ double Biquad::processAudioSample(double xn)
 	return xn; // didn't process anything :(
 }
 
-// --- returns true if coeffs were updated
-bool AudioFilter::calculateFilterCoeffs()
+/**
+\brief calculates the biquad coefficients (including the c0 and d0 wet/dry values) for an
+AudioFilterParameters set; shared by AudioFilter and the statically composed StaticAudioFilter
+
+\param audioFilterParameters the filter algorithm, fc, Q and boost/cut
+\param sampleRate the current sample rate
+\param coeffArray array of numCoeffs values to receive the coefficients
+\returns true if coeffs were updated
+*/
+bool calculateAudioFilterCoeffs(const AudioFilterParameters& audioFilterParameters, double sampleRate, double* coeffArray)
 {
 	// --- clear coeff array
 	memset(&coeffArray[0], 0, sizeof(double)*numCoeffs);
@@ -158,9 +166,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -eT;
 		coeffArray[b2] = 0.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 
@@ -181,9 +186,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -2.0*eP_re*cos(p_Im);
 		coeffArray[b2] = eP_re*eP_re;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -235,9 +237,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b_1;
 		coeffArray[b2] = b_2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -278,9 +277,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b_1;
 		coeffArray[b2] = b_2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -328,9 +324,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b_1;
 		coeffArray[b2] = b_2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -372,9 +365,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b_1;
 		coeffArray[b2] = b_2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -394,9 +384,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = filter_b1;
 		coeffArray[b2] = 0.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -413,9 +400,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -gamma;
 		coeffArray[b2] = 0.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -432,9 +416,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -gamma;
 		coeffArray[b2] = 0.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -458,9 +439,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b2] = 2.0*beta;
 
 		double mag = getMagResponse(theta_c, coeffArray[a0], coeffArray[a1], coeffArray[a2], coeffArray[b1], coeffArray[b2]);
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -484,9 +462,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -2.0*gamma;
 		coeffArray[b2] = 2.0*beta;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -503,9 +478,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = 2.0*Q*(K*K - 1) / delta;
 		coeffArray[b2] = (K*K*Q - K + Q) / delta;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -522,9 +494,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = 2.0*Q*(K*K - 1) / delta;
 		coeffArray[b2] = (K*K*Q - K + Q) / delta;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -541,9 +510,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = 2.0*coeffArray[a0] * (1.0 - C*C);
 		coeffArray[b2] = coeffArray[a0] * (1.0 - kSqrtTwo*C + C*C);
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -560,9 +526,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = 2.0*coeffArray[a0] * (C*C - 1.0);
 		coeffArray[b2] = coeffArray[a0] * (1.0 - kSqrtTwo*C + C*C);
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -584,9 +547,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -coeffArray[a0] * (C*D);
 		coeffArray[b2] = coeffArray[a0] * (C - 1.0);
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -608,9 +568,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = -coeffArray[a0] * D;
 		coeffArray[b2] = coeffArray[a0] * (1.0 - C);
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -645,9 +602,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = filter_b1;
 		coeffArray[b2] = filter_b2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -671,9 +625,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[c0] = mu - 1.0;
 		coeffArray[d0] = 1.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -695,9 +646,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[c0] = mu - 1.0;
 		coeffArray[d0] = 1.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -723,9 +671,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = bBoost ? beta / d0 : beta / e0;
 		coeffArray[b2] = bBoost ? delta / d0 : eta / e0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -758,9 +703,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[c0] = mu - 1.0;
 		coeffArray[d0] = 1.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -782,9 +724,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b1_Num / denominator;
 		coeffArray[b2] = b2_Num / denominator;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -806,9 +745,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = b1_Num / denominator;
 		coeffArray[b2] = b2_Num / denominator;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -826,9 +762,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = alpha;
 		coeffArray[b2] = 0.0;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -852,9 +785,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = beta*(1.0 - alpha);
 		coeffArray[b2] = -alpha;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -874,9 +804,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = filter_b1;
 		coeffArray[b2] = filter_b2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -896,9 +823,6 @@ bool AudioFilter::calculateFilterCoeffs()
 		coeffArray[b1] = filter_b1;
 		coeffArray[b2] = filter_b2;
 
-		// --- update on calculator
-		biquad.setCoefficients(coeffArray);
-
 		// --- we updated
 		return true;
 	}
@@ -907,6 +831,19 @@ bool AudioFilter::calculateFilterCoeffs()
 	return false;
 }
 
+// --- returns true if coeffs were updated
+bool AudioFilter::calculateFilterCoeffs()
+{
+	if (!calculateAudioFilterCoeffs(audioFilterParameters, sampleRate, coeffArray))
+		return false;
+
+	// --- update on calculator
+	biquad.setCoefficients(coeffArray);
+
+	// --- we updated
+	return true;
+}
+
 /**
 \brief process one sample through the audio filter
 
@@ -1023,15 +960,13 @@ const SignalGenData LFO::renderAudioOutput()
 #ifdef HAVE_FFTW
 
 /**
-\brief destroys the FFTW arrays and plans.
+\brief destroys the FFTW arrays; the plans are shared and owned by FFTWPlanRegistry.
 */
 void FastFFT::destroyFFTW()
 {
 #ifdef HAVE_FFTW
-	if (plan_forward)
-		fftw_destroy_plan(plan_forward);
-	if (plan_backward)
-		fftw_destroy_plan(plan_backward);
+	plan_forward = nullptr;
+	plan_backward = nullptr;
 
 	if (fft_input)
 		fftw_free(fft_input);
@@ -1042,6 +977,11 @@ void FastFFT::destroyFFTW()
 		fftw_free(ifft_input);
 	if (ifft_result)
 		fftw_free(ifft_result);
+
+	fft_input = nullptr;
+	fft_result = nullptr;
+	ifft_input = nullptr;
+	ifft_result = nullptr;
 #endif
 }
 
@@ -1136,8 +1076,9 @@ void FastFFT::initialize(unsigned int _frameLength, windowType _window)
 	ifft_input =  (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
 	ifft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
 
-	plan_forward = fftw_plan_dft_1d(frameLength, fft_input, fft_result, FFTW_FORWARD, FFTW_ESTIMATE);
-	plan_backward = fftw_plan_dft_1d(frameLength, ifft_input, ifft_result, FFTW_BACKWARD, FFTW_ESTIMATE);
+	// --- shared plans, run on our arrays with the new-array execute calls
+	plan_forward = FFTWPlanRegistry::getInstance().getPlan(frameLength, fftPlanType::kComplexForward);
+	plan_backward = FFTWPlanRegistry::getInstance().getPlan(frameLength, fftPlanType::kComplexInverse);
 }
 
 /**
@@ -1163,7 +1104,7 @@ fftw_complex* FastFFT::doFFT(double* inputReal, double* inputImag)
 	}
 
 	// --- do the FFT
-	fftw_execute(plan_forward);
+	fftw_execute_dft(plan_forward, fft_input, fft_result);
 
 	return fft_result;
 }
@@ -1191,20 +1132,18 @@ fftw_complex* FastFFT::doInverseFFT(double* inputReal, double* inputImag)
 	}
 
 	// --- do the IFFT
-	fftw_execute(plan_backward);
+	fftw_execute_dft(plan_backward, ifft_input, ifft_result);
 
 	return ifft_result;
 }
 
 /**
-\brief destroys the FFTW arrays and plans.
+\brief destroys the FFTW arrays; the plans are shared and owned by FFTWPlanRegistry.
 */
 void PhaseVocoder::destroyFFTW()
 {
-	if (plan_forward)
-		fftw_destroy_plan(plan_forward);
-	if (plan_backward)
-		fftw_destroy_plan(plan_backward);
+	plan_forward = nullptr;
+	plan_backward = nullptr;
 
 	if (fft_input)
 		fftw_free(fft_input);
@@ -1212,6 +1151,10 @@ void PhaseVocoder::destroyFFTW()
 		fftw_free(fft_result);
 	if (ifft_result)
 		fftw_free(ifft_result);
+
+	fft_input = nullptr;
+	fft_result = nullptr;
+	ifft_result = nullptr;
 }
 
 /**
@@ -1352,8 +1295,9 @@ void PhaseVocoder::initialize(unsigned int _frameLength, unsigned int _hopSize,
 	fft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
 	ifft_result = (fftw_complex*)fftw_malloc(sizeof(fftw_complex) * frameLength);
 
-	plan_forward = fftw_plan_dft_1d(frameLength, fft_input, fft_result, FFTW_FORWARD, FFTW_ESTIMATE);
-	plan_backward = fftw_plan_dft_1d(frameLength, fft_result, ifft_result, FFTW_BACKWARD, FFTW_ESTIMATE);
+	// --- shared plans, run on our arrays with the new-array execute calls
+	plan_forward = FFTWPlanRegistry::getInstance().getPlan(frameLength, fftPlanType::kComplexForward);
+	plan_backward = FFTWPlanRegistry::getInstance().getPlan(frameLength, fftPlanType::kComplexInverse);
 #endif
 }
 
@@ -1416,7 +1360,7 @@ bool PhaseVocoder::advanceAndCheckFFT()
 	}
 
 	// --- do the FFT
-	fftw_execute(plan_forward);
+	fftw_execute_dft(plan_forward, fft_input, fft_result);
 
 	// --- in case user does not take IFFT, just to prevent zero output
 	needInverseFFT = true;
@@ -1493,7 +1437,7 @@ then you can call this function at the appropriate time - see the PSMVocoder obj
 void PhaseVocoder::doInverseFFT()
 {
 	// do the IFFT
-	fftw_execute(plan_backward);
+	fftw_execute_dft(plan_backward, fft_result, ifft_result);
 
 	// --- output is now in ifft_result array
 	needInverseFFT = false;
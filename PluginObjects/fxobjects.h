@@ -19,6 +19,8 @@
 
 #include <memory>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 #include "guiconstants.h"
 #include "filters.h"
 #include <time.h>       /* time */
@@ -284,6 +286,104 @@ inline double dB2Raw(double dB)
 	return pow(10.0, (dB / 20.0));
 }
 
+// --- constants for the fast dB conversions; literals so they are safe during static initialization
+const double kLn2 = 0.69314718055994531;				///< ln(2)
+const double kInvLn2 = 1.4426950408889634;				///< 1/ln(2)
+const double kLog2Of10Over20 = 0.16609640474436813;		///< log2(10)/20: dB -> base-2 exponent
+const double kdBPerOctaveOfGain = 6.0205999132796239;	///< 20*log10(2): base-2 exponent -> dB
+
+/**
+@fastExp2
+\ingroup FX-Functions
+
+@brief calculates 2^x without calling pow( ) or exp( )
+
+- x is split into an integer n (rounded) and a remainder |r| <= 0.5; 2^r = e^(r*ln2) is a degree-7 Taylor
+  polynomial and 2^n is written straight into the exponent field
+- relative error < 1e-8 (truncation bound (0.5*ln2)^8/8!); x is clamped to [-1022, +1023] so the result
+  is always a normal double
+
+\param x - the exponent
+\return 2^x
+*/
+inline double fastExp2(double x)
+{
+	x = x < -1022.0 ? -1022.0 : (x > 1023.0 ? 1023.0 : x);
+
+	double n = floor(x + 0.5);
+	double f = (x - n)*kLn2;
+	double p = 1.0 + f*(1.0 + f*(1.0/2.0 + f*(1.0/6.0 + f*(1.0/24.0 + f*(1.0/120.0 + f*(1.0/720.0 + f*(1.0/5040.0)))))));
+
+	int64_t bits = (int64_t)(n + 1023.0) << 52;
+	double scale = 0.0;
+	memcpy(&scale, &bits, sizeof(double));
+	return p*scale;
+}
+
+/**
+@fastLog2
+\ingroup FX-Functions
+
+@brief calculates log2(x) for a positive, normal x without calling log( )
+
+- the exponent field gives the integer part; the mantissa m is folded into [sqrt(1/2), sqrt(2)) and
+  ln(m) = 2*atanh(t), t = (m-1)/(m+1), is summed to t^9
+- absolute error < 1e-9 (truncation bound 2|t|^11/11 with |t| <= 0.1716)
+
+\param x - the value, must be >= kSmallestPositiveFloatValue (use raw2dBFast( ) for a guarded dB version)
+\return log2(x)
+*/
+inline double fastLog2(double x)
+{
+	int64_t bits = 0;
+	memcpy(&bits, &x, sizeof(double));
+	double e = (double)(((bits >> 52) & 0x7FF) - 1023);
+
+	bits = (bits & 0x000FFFFFFFFFFFFFLL) | 0x3FF0000000000000LL;
+	double m = 1.0;
+	memcpy(&m, &bits, sizeof(double));
+	if (m > 1.4142135623730951)
+	{
+		m *= 0.5;
+		e += 1.0;
+	}
+
+	double t = (m - 1.0) / (m + 1.0);
+	double t2 = t*t;
+	double lnm = 2.0*t*(1.0 + t2*(1.0/3.0 + t2*(1.0/5.0 + t2*(1.0/7.0 + t2*(1.0/9.0)))));
+	return e + lnm*kInvLn2;
+}
+
+/**
+@dB2RawFast
+\ingroup FX-Functions
+
+@brief converts dB to raw value with fastExp2( ); relative error < 1e-8 (about 1e-7 dB), use for per-sample gains
+
+\param dB - value to convert to raw
+\return the raw value
+*/
+inline double dB2RawFast(double dB)
+{
+	return fastExp2(dB*kLog2Of10Over20);
+}
+
+/**
+@raw2dBFast
+\ingroup FX-Functions
+
+@brief calculates dB for given input with fastLog2( ); absolute error < 1e-8 dB, use for per-sample detectors
+
+\param raw - value to convert to dB; values below the smallest normal float fall back to raw2dB( )
+\return the dB value
+*/
+inline double raw2dBFast(double raw)
+{
+	if (raw < kSmallestPositiveFloatValue)
+		return raw2dB(raw);
+	return fastLog2(raw)*kdBPerOctaveOfGain;
+}
+
 /**
 @peakGainFor_Q
 \ingroup FX-Functions
@@ -1200,6 +1300,65 @@ public:
 		// --- do nothing
 		return false; // NOT handled
 	}
+
+	/** optional 64-bit version of processAudioFrame( ), for hosts that deliver double buffers
+	--- the default narrows the frame to float and calls processAudioFrame( ); objects that compute in double
+	    should override it so the samples never leave double precision */
+	virtual bool processAudioFrame64(const double* inputFrame,	/* ptr to one frame of data: pInputFrame[0] = left, pInputFrame[1] = right, etc...*/
+									 double* outputFrame,
+									 uint32_t inputChannels,
+									 uint32_t outputChannels)
+	{
+		const uint32_t kMaxFrameChannels = 8;
+		if (inputChannels > kMaxFrameChannels || outputChannels > kMaxFrameChannels)
+			return false; // NOT handled
+
+		float inputFloat[kMaxFrameChannels] = { 0.f };
+		float outputFloat[kMaxFrameChannels] = { 0.f };
+		for (uint32_t i = 0; i < inputChannels; i++)
+			inputFloat[i] = (float)inputFrame[i];
+
+		if (!processAudioFrame(inputFloat, outputFloat, inputChannels, outputChannels))
+			return false; // NOT handled
+
+		for (uint32_t i = 0; i < outputChannels; i++)
+			outputFrame[i] = outputFloat[i];
+		return true;
+	}
+
+	/** optional block version of processAudioFrame( ): numFrames frames of interleaved data, frameStride samples
+	    apart; the default calls processAudioFrame( ) per frame. Objects run inside a processing graph should override
+	    it with a loop over their inlined frame code, so the graph pays one virtual call per stage per block */
+	virtual bool processAudioFrames(const float* input,		/* ptr to the first frame of the block */
+									float* output,
+									uint32_t numFrames,
+									uint32_t frameStride,	/* samples from one frame to the next */
+									uint32_t inputChannels,
+									uint32_t outputChannels)
+	{
+		for (uint32_t n = 0; n < numFrames; n++)
+		{
+			if (!processAudioFrame(input + n*frameStride, output + n*frameStride, inputChannels, outputChannels))
+				return false; // NOT handled
+		}
+		return true;
+	}
+
+	/** optional 64-bit version of processAudioFrames( ); the default calls processAudioFrame64( ) per frame */
+	virtual bool processAudioFrames64(const double* input,	/* ptr to the first frame of the block */
+									  double* output,
+									  uint32_t numFrames,
+									  uint32_t frameStride,	/* samples from one frame to the next */
+									  uint32_t inputChannels,
+									  uint32_t outputChannels)
+	{
+		for (uint32_t n = 0; n < numFrames; n++)
+		{
+			if (!processAudioFrame64(input + n*frameStride, output + n*frameStride, inputChannels, outputChannels))
+				return false; // NOT handled
+		}
+		return true;
+	}
 };
 
 /**
@@ -1484,6 +1643,7 @@ Custom parameter structure for the AudioFilter object.
 struct AudioFilterParameters
 {
 	AudioFilterParameters(){}
+	AudioFilterParameters(const AudioFilterParameters&) = default;
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	AudioFilterParameters& operator=(const AudioFilterParameters& params)	// need this override for collections to work
 	{
@@ -1504,6 +1664,9 @@ struct AudioFilterParameters
 	double boostCut_dB = 0.0; ///< filter gain; note not used in all types
 };
 
+/** --- calculate the coefficients (incl. c0 and d0) for a filter parameter set; returns true if coeffs were updated */
+bool calculateAudioFilterCoeffs(const AudioFilterParameters& audioFilterParameters, double sampleRate, double* coeffArray);
+
 /**
 \class AudioFilter
 \ingroup FX-Objects
@@ -1642,6 +1805,7 @@ split frequencies to support more bands.
 struct LRFilterBankParameters
 {
 	LRFilterBankParameters() {}
+	LRFilterBankParameters(const LRFilterBankParameters&) = default;
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	LRFilterBankParameters& operator=(const LRFilterBankParameters& params)	// need this override for collections to work
 	{
@@ -1789,6 +1953,7 @@ Custom parameter structure for the AudioDetector object. NOTE: this object uses
 struct AudioDetectorParameters
 {
 	AudioDetectorParameters() {}
+	AudioDetectorParameters(const AudioDetectorParameters&) = default;
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	AudioDetectorParameters& operator=(const AudioDetectorParameters& params)	// need this override for collections to work
 	{
@@ -1898,7 +2063,7 @@ public:
 		}
 
 		// --- true log output in dB, can go above 0dBFS!
-		return 20.0*log10(currEnvelope);
+		return raw2dBFast(currEnvelope);
 	}
 
 	/** get parameters: note use of custom structure for passing param data */
@@ -2119,7 +2284,7 @@ public:
 		double gr = computeGain(detect_dB);
 
 		// --- makeup gain
-		double makeupGain = pow(10.0, parameters.outputGain_dB / 20.0);
+		double makeupGain = dB2RawFast(parameters.outputGain_dB);
 
 		// --- do DCA + makeup gain
 		return xn * gr * makeupGain;
@@ -2210,7 +2375,7 @@ protected:
 
 		// --- convert gain; store values for user meters
 		parameters.gainReduction_dB = output_dB - detect_dB;
-		parameters.gainReduction = pow(10.0, (parameters.gainReduction_dB) / 20.0);
+		parameters.gainReduction = dB2RawFast(parameters.gainReduction_dB);
 
 		// --- the current gain coefficient value
 		return parameters.gainReduction;
@@ -4852,8 +5017,8 @@ public:
 		double tankOutR = shelvingFilters[1].processAudioSample(outR);
 
 		// --- sum with dry
-		double dry = pow(10.0, parameters.dryLevel_dB / 20.0);
-		double wet = pow(10.0, parameters.wetLevel_dB / 20.0);
+		double dry = dB2RawFast(parameters.dryLevel_dB);
+		double wet = dB2RawFast(parameters.wetLevel_dB);
 
 		if (outputChannels == 1)
 			outputFrame[0] = dry*xnL + wet*(0.5*tankOutL + 0.5*tankOutR);
@@ -5014,7 +5179,7 @@ public:
 	*/
 	virtual double processAudioSample(double xn)
 	{
-		return dB2Raw(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
+		return dB2RawFast(makeUpGain_dB)*xn*computeGain(detector.processAudioSample(xn));
 	}
 
 	/** compute the gain reductino value based on detected value in dB */
@@ -5051,7 +5216,7 @@ public:
 		}
 
 		// --- convert difference between threshold and detected to raw
-		return  pow(10.0, (output_dB - detect_dB) / 20.0);
+		return  dB2RawFast(output_dB - detect_dB);
 	}
 
 	/** adjust threshold in dB */
@@ -5271,7 +5436,7 @@ public:
 		integrator_z[0] = alpha*hpf + bpf;
 		integrator_z[1] = alpha*bpf + lpf;
 
-		double filterOutputGain = pow(10.0, zvaFilterParameters.filterOutputGain_dB / 20.0);
+		double filterOutputGain = dB2RawFast(zvaFilterParameters.filterOutputGain_dB);
 
 		// return our selected type
 		if (filterAlgorithm == vaFilterAlgorithm::kSVF_LP)
@@ -5366,6 +5531,7 @@ Custom parameter structure for the EnvelopeFollower object.
 struct EnvelopeFollowerParameters
 {
 	EnvelopeFollowerParameters() {}
+	EnvelopeFollowerParameters(const EnvelopeFollowerParameters&) = default;
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	EnvelopeFollowerParameters& operator=(const EnvelopeFollowerParameters& params)	// need this override for collections to work
 	{
@@ -5521,11 +5687,11 @@ public:
 		 //return filter.processAudioSample(xn);
 
 		// --- calc threshold
-		double threshValue = pow(10.0, parameters.threshold_dB / 20.0);
+		double threshValue = dB2RawFast(parameters.threshold_dB);
 
 		// --- detect the signal
 		double detect_dB = detector.processAudioSample(xn);
-		double detectValue = pow(10.0, detect_dB / 20.0);
+		double detectValue = dB2RawFast(detect_dB);
 		double deltaValue = detectValue - threshValue;
 
 		AudioFilterParameters filterParams = filter.getParameters();
@@ -8759,6 +8925,7 @@ inline std::unique_ptr<double[]> makeWindow(unsigned int windowLength, unsigned
 // --- FFTW ---
 #ifdef HAVE_FFTW
 #include "fftw3.h"
+#include "fftwplanregistry.h"
 
 /**
 \class FastFFT
@@ -8789,7 +8956,7 @@ public:
 	/** setup the FFT for a given framelength and window type*/
 	void initialize(unsigned int _frameLength, windowType _window);
 
-	/** destroy FFTW objects and plans */
+	/** free the FFTW arrays; the plans belong to FFTWPlanRegistry */
 	void destroyFFTW();
 
 	/** do the FFT and return real and imaginary arrays */
@@ -8807,8 +8974,8 @@ protected:
 	fftw_complex*	fft_result = nullptr;		///< array for FFT output
 	fftw_complex*	ifft_input = nullptr;		///< array for IFFT input
 	fftw_complex*	ifft_result = nullptr;		///< array for IFFT output
-	fftw_plan       plan_forward = nullptr;		///< FFTW plan for FFT
-	fftw_plan		plan_backward = nullptr;	///< FFTW plan for IFFT
+	fftw_plan       plan_forward = nullptr;		///< shared FFTW plan for FFT (owned by FFTWPlanRegistry)
+	fftw_plan		plan_backward = nullptr;	///< shared FFTW plan for IFFT (owned by FFTWPlanRegistry)
 
 	double* windowBuffer = nullptr;				///< buffer for window (naked)
 	double windowGainCorrection = 1.0;			///< window gain correction
@@ -8850,7 +9017,7 @@ public:
 	/** setup the FFT for a given framelength and window type*/
 	void initialize(unsigned int _frameLength, unsigned int _hopSize, windowType _window);
 
-	/** destroy FFTW objects and plans */
+	/** free the FFTW arrays; the plans belong to FFTWPlanRegistry */
 	void destroyFFTW();
 
 	/** process audio sample through vocode; check fftReady flag to access FFT output */
@@ -8893,8 +9060,8 @@ protected:
 	fftw_complex*	fft_input = nullptr;		///< array for FFT input
 	fftw_complex*	fft_result = nullptr;		///< array for FFT output
 	fftw_complex*	ifft_result = nullptr;		///< array for IFFT output
-	fftw_plan       plan_forward = nullptr;		///< FFTW plan for FFT
-	fftw_plan		plan_backward = nullptr;	///< FFTW plan for IFFT
+	fftw_plan       plan_forward = nullptr;		///< shared FFTW plan for FFT (owned by FFTWPlanRegistry)
+	fftw_plan		plan_backward = nullptr;	///< shared FFTW plan for IFFT (owned by FFTWPlanRegistry)
 
 	// --- linear buffer for window
 	double*			windowBuffer = nullptr;		///< array for window
@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef __GainRamp__
+#define __GainRamp__
+
+#include <stdint.h>
+
+/** @file gainramp.h
+\brief block-rate linear gain ramp used in place of per-sample parameter smoothing for gain-type controls
+*/
+
+/**
+\class GainRamp
+\ingroup FX-Objects
+\brief
+The GainRamp object glides a linear gain from its current value to a new target over a fixed number
+of samples (normally one processing block), so gain knobs and automation do not zipper.
+
+- the target is cooked (dB -> linear) once, when the control changes; the per-sample cost is one add
+- a new target while a ramp is running starts a fresh ramp from wherever the gain currently is
+- snapToTarget( ) skips the ramp, e.g. for the first parameter update after a reset
+
+Control I/F:
+- setRampLength( ) once per block (the owner knows the block size)
+- setTargetGain( ) whenever the cooked gain changes
+- getNextGain( ) once per sample
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class GainRamp
+{
+public:
+	GainRamp(void) {}	/* C-TOR */
+	~GainRamp(void) {}	/* D-TOR */
+
+	/** set the ramp length in samples; takes effect on the next setTargetGain( ) */
+	/**
+	\param samples ramp length; 0 makes every change a step
+	*/
+	void setRampLength(uint32_t samples) { rampLength = samples; }
+
+	/** start a ramp from the current gain to a new target; does nothing if the target is unchanged */
+	/**
+	\param gain the new target as a linear gain
+	*/
+	void setTargetGain(double gain)
+	{
+		if (gain == targetGain)
+			return;
+
+		targetGain = gain;
+		if (rampLength == 0)
+		{
+			snapToTarget();
+			return;
+		}
+
+		increment = (targetGain - currentGain) / rampLength;
+		samplesLeft = rampLength;
+	}
+
+	/** jump straight to a gain with no ramp */
+	/**
+	\param gain the new linear gain
+	*/
+	void snapToGain(double gain)
+	{
+		targetGain = gain;
+		snapToTarget();
+	}
+
+	/** end any running ramp at its target */
+	void snapToTarget()
+	{
+		currentGain = targetGain;
+		increment = 0.0;
+		samplesLeft = 0;
+	}
+
+	/** advance one sample; the last ramp step lands exactly on the target */
+	/**
+	\return the gain for this sample
+	*/
+	inline double getNextGain()
+	{
+		if (samplesLeft > 0)
+		{
+			if (--samplesLeft == 0)
+				currentGain = targetGain;
+			else
+				currentGain += increment;
+		}
+		return currentGain;
+	}
+
+	/** \return the gain of the most recent sample */
+	double getCurrentGain() { return currentGain; }
+
+	/** \return the gain the ramp is heading for (the cooked value) */
+	double getTargetGain() { return targetGain; }
+
+	/** \return true while a ramp is running */
+	bool isRamping() { return samplesLeft > 0; }
+
+private:
+	double currentGain = 1.0;	///< gain of the most recent sample
+	double targetGain = 1.0;	///< gain at the end of the ramp
+	double increment = 0.0;		///< per-sample step
+	uint32_t samplesLeft = 0;	///< samples until the ramp reaches targetGain
+	uint32_t rampLength = 0;	///< ramp length in samples
+};
+
+#endif
@@ -4,7 +4,11 @@
 #define __ModFilter__
 
 #include "fxobjects.h"
+#include "staticfxobjects.h"
+#include "dspstatearena.h"
 #include "superlfo.h"
+#include "gainramp.h"
+#include "filtercurve.h"
 
 /**
 \struct ModFilterParameters
@@ -23,6 +27,7 @@ enum class FilterSelect {kLPF,kBPF,kHPF};
 struct ModFilterParameters
 {
 	ModFilterParameters() {}
+	ModFilterParameters(const ModFilterParameters&) = default;
 
 	/** all FXObjects parameter objects require overloaded= operator so remember to add new entries if you add new variables. */
 	ModFilterParameters& operator=(const ModFilterParameters& params)	// need this override for collections to work
@@ -122,6 +127,13 @@ public:
 		// --- store the sample rate
 		sampleRate = (_sampleRate);
 
+		// --- stand-alone use: no owner supplied an arena, so use our own
+		if (!arenaBound)
+		{
+			ownedArena.reset(new DSPStateArenaStorage);
+			bindToArena(ownedArena->get());
+		}
+
 		modLFO.reset(_sampleRate);
 
 		SuperLFOParameters lfoParams = modLFO.getParameters();
@@ -134,9 +146,35 @@ public:
 		modFilters[2].reset(_sampleRate);
 		modFilters[3].reset(_sampleRate);
 
+		// --- the first gains after a reset are applied without a ramp
+		snapGains = true;
+
 		return true;
 	}
 
+	/** set the length of the gain ramps; the owner calls this once per block with the block size */
+	/**
+	\param samples ramp length in samples
+	*/
+	void setGainRampLength(uint32_t samples)
+	{
+		dryVolumeRamp.setRampLength(samples);
+		filterBoostRamp.setRampLength(samples);
+	}
+
+	/** bind the envelope followers to a state arena; the owner (e.g. PluginCore) calls this before reset( ) */
+	/**
+	\param arena the per-instance arena that holds the hot filter and detector state
+	\return true if all filters and detectors found a slot
+	*/
+	bool bindToArena(DSPStateArena& arena)
+	{
+		arenaBound = true;
+		for (int i = 0; i < 4; i++)
+			arenaBound = modFilters[i].bindToArena(arena) && arenaBound;
+		return arenaBound;
+	}
+
 	/** process MONO input */
 	/**
 	\param xn input
@@ -160,6 +198,64 @@ public:
 					     uint32_t inputChannels,
 					     uint32_t outputChannels)
 	{
+		return processFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+	}
+
+	/** process a 64-bit audio frame; identical DSP, with no narrowing to float between stages */
+	virtual bool processAudioFrame64(const double* inputFrame,
+					     double* outputFrame,
+					     uint32_t inputChannels,
+					     uint32_t outputChannels)
+	{
+		return processFrame(inputFrame, outputFrame, inputChannels, outputChannels);
+	}
+
+	/** process a block of interleaved frames: one virtual call, processFrame( ) inlined in the loop */
+	virtual bool processAudioFrames(const float* input,
+					     float* output,
+					     uint32_t numFrames,
+					     uint32_t frameStride,
+					     uint32_t inputChannels,
+					     uint32_t outputChannels)
+	{
+		return processFrames(input, output, numFrames, frameStride, inputChannels, outputChannels);
+	}
+
+	/** process a block of interleaved 64-bit frames */
+	virtual bool processAudioFrames64(const double* input,
+					     double* output,
+					     uint32_t numFrames,
+					     uint32_t frameStride,
+					     uint32_t inputChannels,
+					     uint32_t outputChannels)
+	{
+		return processFrames(input, output, numFrames, frameStride, inputChannels, outputChannels);
+	}
+
+	/** shared body of the float and double processAudioFrames( ) versions */
+	template <typename SampleType>
+	bool processFrames(const SampleType* input,
+					     SampleType* output,
+					     uint32_t numFrames,
+					     uint32_t frameStride,
+					     uint32_t inputChannels,
+					     uint32_t outputChannels)
+	{
+		for (uint32_t n = 0; n < numFrames; n++)
+		{
+			if (!processFrame(input + n*frameStride, output + n*frameStride, inputChannels, outputChannels))
+				return false; // NOT handled (channel format, same for every frame)
+		}
+		return true;
+	}
+
+	/** shared body of the float and double processAudioFrame( ) versions; the DSP runs in double either way */
+	template <typename SampleType>
+	bool processFrame(const SampleType* inputFrame,
+					     SampleType* outputFrame,
+					     uint32_t inputChannels,
+					     uint32_t outputChannels)
+	{
 		
 		double xnL = inputFrame[0];
 		double xnR = inputFrame[1];
@@ -168,6 +264,10 @@ public:
 		double ynL = xnL;
 		double ynR = xnR;
 
+		// --- one ramp step per frame, whether or not the filter is enabled
+		double dryGain = dryVolumeRamp.getNextGain();
+		double boostGain = filterBoostRamp.getNextGain();
+
 
 		// --- check for filter enable
 		if (parameters.enableModFilter)
@@ -231,16 +331,16 @@ public:
 			if (parameters.filterSelection == FilterSelect::kBPF ||
 				parameters.filterSelection == FilterSelect::kHPF)
 			{
-				ynL *= filterBoost_cooked;
-				ynR *= filterBoost_cooked;
+				ynL *= boostGain;
+				ynR *= boostGain;
 
 				/*filterDouble_L *= filterBoost_cooked;
 				filterDouble_R *= filterBoost_cooked;*/
 			}
 			else if (parameters.filterSelection == FilterSelect::kLPF)
 			{
-				ynL *= (filterBoost_cooked / 2);
-				ynR *= (filterBoost_cooked / 2);
+				ynL *= (boostGain / 2);
+				ynR *= (boostGain / 2);
 
 				/*filterDouble_L *= (filterBoost_cooked / 2);
 				filterDouble_R *= (filterBoost_cooked / 2);*/
@@ -251,27 +351,28 @@ public:
 		// --- check channel selection
 		if (inputChannels == 1 && outputChannels == 1)
 		{
-			outputFrame[0] = ynL + xnL * dryVolume_cooked + filterDouble_L;
+			outputFrame[0] = ynL + xnL * dryGain + filterDouble_L;
 
 			return true;
 		}
 
 		else if (inputChannels == 1 && outputChannels == 2)
 		{
-			outputFrame[0] = ynL + xnL * dryVolume_cooked + filterDouble_L;
-			outputFrame[1] = ynL + xnL * dryVolume_cooked + filterDouble_L;
+			outputFrame[0] = ynL + xnL * dryGain + filterDouble_L;
+			outputFrame[1] = ynL + xnL * dryGain + filterDouble_L;
 
 			return true;
 		}
 
 		else if (inputChannels == 2 && outputChannels == 2)
 		{
-			outputFrame[0] = ynL + xnL * dryVolume_cooked + filterDouble_L;
-			outputFrame[1] = ynR + xnR * dryVolume_cooked + filterDouble_R;
+			outputFrame[0] = ynL + xnL * dryGain + filterDouble_L;
+			outputFrame[1] = ynR + xnR * dryGain + filterDouble_R;
 
 			return true;
 		}
 
+		return false; // NOT handled
 	}
 
 
@@ -284,6 +385,34 @@ public:
 		return parameters;
 	}
 
+	/** \return the filter's current cutoff in Hz, after envelope and LFO modulation; 0 when the filter is off */
+	double getModulatedFc()
+	{
+		return parameters.enableModFilter ? modFilters[0].getFilterFc() : 0.0;
+	}
+
+	/** fill in the ModFilter's part of a filter curve snapshot: the current (modulated) coefficients and cooked gains */
+	/**
+	\param snapshot the snapshot to fill; the other fields are left alone
+	*/
+	void getFilterCurve(FilterCurveSnapshot& snapshot)
+	{
+		static_assert(numCoeffs == FILTER_CURVE_NUM_COEFFS, "FilterCurveSnapshot must match filterCoeff");
+
+		// --- left and right filters are identical; the left ones stand for both
+		modFilters[0].getFilterCoefficients(snapshot.modFilter);
+		modFilters[2].getFilterCoefficients(snapshot.modFilterDouble);
+
+		// --- same boost as processFrame( ): halved for the LPF
+		snapshot.modFilterGain = filterBoostRamp.getTargetGain();
+		if (parameters.filterSelection == FilterSelect::kLPF)
+			snapshot.modFilterGain *= 0.5;
+
+		snapshot.modFilterDryGain = dryVolumeRamp.getTargetGain();
+		snapshot.modFilterEnabled = parameters.enableModFilter ? 1 : 0;
+		snapshot.modFilterDoubled = parameters.enableDouble ? 1 : 0;
+	}
+
 	/** set parameters: note use of custom structure for passing param data */
 	/**
 	\param ModFilterParameters custom data structure
@@ -294,21 +423,26 @@ public:
 		//     and copy the variables one at a time, or you may test
 		//     to see if cook-able variables have changed; if not, then
 		//     do not re-cook them as it just wastes CPU
+		bool gainsChanged = snapGains ||
+			params.dryVolume != parameters.dryVolume ||
+			params.filterBoost != parameters.filterBoost;
+
 		parameters = params;
 
-		// --- set dry volume range
-		if (parameters.dryVolume <= -15.0)
-		{
-			dryVolume_cooked = 0.0;
-		}
-		else
+		// --- cook gains; the ramps glide to the new values
+		if (gainsChanged)
 		{
-			dryVolume_cooked = pow(10, parameters.dryVolume / 20);
+			// --- set dry volume range
+			if (parameters.dryVolume <= -15.0)
+				setGain(dryVolumeRamp, 0.0);
+			else
+				setGain(dryVolumeRamp, dB2Raw(parameters.dryVolume));
+
+			setGain(filterBoostRamp, dB2Raw(parameters.filterBoost));
+
+			snapGains = false;
 		}
 		
-		parameters.filterBoost = params.filterBoost;
-		filterBoost_cooked = pow(10, parameters.filterBoost / 20);
-		
 		
 
 		EnvelopeFollowerParameters filterParams = modFilters[0].getParameters();
@@ -364,15 +498,27 @@ public:
 	}
 
 private:
+	/** ramp to a cooked gain, or jump to it on the first update after reset( ) */
+	void setGain(GainRamp& ramp, double gain)
+	{
+		if (snapGains)
+			ramp.snapToGain(gain);
+		else
+			ramp.setTargetGain(gain);
+	}
+
 	ModFilterParameters parameters; ///< object parameters
 
-	EnvelopeFollower modFilters[4];
+	StaticEnvelopeFollower<ArenaAudioFilter, ArenaAudioDetector> modFilters[4]; ///< hot state lives in the bound DSPStateArena
+	bool arenaBound = false;							///< true once bindToArena( ) succeeded
+	std::unique_ptr<DSPStateArenaStorage> ownedArena;	///< only for stand-alone use
 	SuperLFO modLFO;
 
 	// --- local variables used by this object
 	double sampleRate = 0.0;	///< sample rate
-	double dryVolume_cooked;
-	double filterBoost_cooked;
+	GainRamp dryVolumeRamp;		///< cooked dry gain, ramped over one block
+	GainRamp filterBoostRamp;	///< cooked boost gain, ramped over one block
+	bool snapGains = true;		///< next gain update skips the ramp (set by reset( ))
 	double lfoModifier = 0.0;
 
 	double filterDouble_L = 0.0;
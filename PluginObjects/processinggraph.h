@@ -0,0 +1,523 @@
+#pragma once
+
+#ifndef __ProcessingGraph__
+#define __ProcessingGraph__
+
+#include "fxobjects.h"
+#include "stageprofiler.h"
+
+/** @file processinggraph.h
+\brief a small static DSP graph: stages and weighted connections are described once, compiled into a flat
+execution list over block buffers taken from a GraphBlockArena, then run one block at a time with no per-sample
+topology branching.
+*/
+
+// --- graph limits; the description is fixed-size and the block buffers are reserved up front, so describing and
+//     compiling never allocate (safe on the audio thread)
+const unsigned int kMaxGraphStages = 8;				///< processing stages per graph
+const unsigned int kMaxGraphConnections = 16;		///< connections per graph
+const unsigned int kGraphChannels = 2;				///< block buffers are interleaved stereo
+const unsigned int kGraphBlockFrames = MAX_PROCESS_BLOCK_FRAMES;	///< frames per block buffer
+const unsigned int kGraphBlockSamples = kGraphBlockFrames * kGraphChannels;	///< samples per block buffer
+const uint32_t kGraphInput = 0;						///< node index of the graph input
+const uint32_t kGraphOutput = kMaxGraphStages + 1;	///< node index of the graph output
+
+/**
+\class GraphBlockArena
+\ingroup FX-Objects
+\brief
+The GraphBlockArena object owns the block buffers of one plugin instance's processing graphs.
+
+- buffers are sized for double; a float graph uses the front half of each, so the float and double graphs of an
+  instance can share one arena (only one of them runs in any block, and neither keeps data in its buffers between
+  blocks)
+- reserve( ) allocates, so call it outside the audio thread and recompile the graphs after it; buffer 0 is the
+  graph input, the others are handed out by compile( ) in order
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class GraphBlockArena
+{
+public:
+	GraphBlockArena(void) {}	/* C-TOR */
+	~GraphBlockArena(void) {}	/* D-TOR */
+
+	GraphBlockArena(const GraphBlockArena&) = delete;
+	GraphBlockArena& operator=(const GraphBlockArena&) = delete;
+
+	/** make sure there are at least numBuffers block buffers; existing buffers move when it grows */
+	void reserve(uint32_t _numBuffers)
+	{
+		if (_numBuffers <= numBuffers)
+			return;
+
+		// --- operator new gives 16-byte alignment, enough for SSE loads
+		storage.reset(new double[_numBuffers * kGraphBlockSamples]);
+		memset(storage.get(), 0, sizeof(double) * _numBuffers * kGraphBlockSamples);
+		numBuffers = _numBuffers;
+	}
+
+	/** \return the number of block buffers */
+	uint32_t getNumBuffers() { return numBuffers; }
+
+	/** \return block buffer index as SampleType samples (float or double) */
+	template <typename SampleType>
+	SampleType* getBuffer(uint32_t index)
+	{
+		return index < numBuffers ? reinterpret_cast<SampleType*>(storage.get() + index * kGraphBlockSamples) : nullptr;
+	}
+
+protected:
+	std::unique_ptr<double[]> storage;	///< numBuffers x kGraphBlockSamples doubles
+	uint32_t numBuffers = 0;			///< buffers in storage
+};
+
+/**
+\struct GraphConnection
+\ingroup FX-Objects
+\brief
+One weighted edge of a ProcessingGraph: the destination's input is the gain-weighted sum of all its sources.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+struct GraphConnection
+{
+	GraphConnection() {}
+	GraphConnection(uint32_t _source, uint32_t _destination, float _gain)
+		: source(_source), destination(_destination), gain(_gain) {}
+
+	uint32_t source = kGraphInput;			///< node whose output is read
+	uint32_t destination = kGraphOutput;	///< node whose input is written
+	float gain = 1.0f;						///< weight of this source in the destination's input sum
+};
+
+/**
+\class SampleProcessingGraph
+\ingroup FX-Objects
+\brief
+The SampleProcessingGraph object runs a set of IAudioSignalProcessor stages in a topology described at run time.
+ProcessingGraph runs float blocks through processAudioFrames( ); ProcessingGraph64 runs double blocks through
+processAudioFrames64( ) for hosts that deliver 64-bit buffers.
+
+Nodes are kGraphInput (0), the stages (1..N, in the order they were added) and kGraphOutput. compile( ) orders the
+stages topologically and assigns each node a block buffer from the GraphBlockArena:
+- a node with a single unity-gain source reads that source's buffer directly (no copy)
+- a node with several sources, or any non-unity gain, gets a mix step that sums them into a buffer of its own
+- a node with no sources reads a shared, read-only block of silence
+- every stage then processes a whole block with one processAudioFrames( ) (processAudioFrames64( )) call before the
+  next stage runs; each stage output takes one buffer, so a two-stage chain uses three (input included)
+
+Control I/F:
+- setArena( ) once; getNumBlockBuffers( ) after a compile( ) says how many buffers that topology needs
+- clear( ), addStage( ), connect( ), compile( ) whenever the topology changes
+- once per block: writeInputBlock( ) (or fill getInputBuffer( ), interleaved kGraphChannels wide), process( ), readOutputBlock( )
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <typename SampleType>
+class SampleProcessingGraph
+{
+public:
+	SampleProcessingGraph(void) { clear(); }	/* C-TOR */
+	~SampleProcessingGraph(void) {}			/* D-TOR */
+
+	/** use an arena's block buffers; the graph passes nothing until it is compiled again */
+	void setArena(GraphBlockArena* _arena)
+	{
+		arena = _arena;
+		numSteps = 0;
+		compiled = false;
+		outputBuffer = getSilence();
+	}
+
+	/** remove all stages and connections; the graph passes nothing until it is compiled again */
+	void clear()
+	{
+		numStages = 0;
+		numConnections = 0;
+		numSteps = 0;
+		compiled = false;
+		outputBuffer = getSilence();
+#ifdef ENABLE_STAGE_PROFILING
+		for (uint32_t node = 1; node <= kMaxGraphStages; node++)
+			profiledStage[node] = kNumProfiledStages;	// not timed until setProfiledStage( )
+#endif
+	}
+
+	/** add a processing stage */
+	/**
+	\param stage the processor; it must be able to process frames (see IAudioSignalProcessor::canProcessAudioFrame( ))
+	\return the stage's node index (1..kMaxGraphStages), or kGraphInput if the graph is full
+	*/
+	uint32_t addStage(IAudioSignalProcessor* stage)
+	{
+		if (!stage || numStages >= kMaxGraphStages)
+			return kGraphInput;
+
+		stages[numStages++] = stage;
+		compiled = false;
+		return numStages;
+	}
+
+	/** connect two nodes; several connections into one node are summed */
+	/**
+	\param source kGraphInput or a stage node
+	\param destination a stage node or kGraphOutput
+	\param gain weight of the source in the destination's input
+	\return true if the connection was stored
+	*/
+	bool connect(uint32_t source, uint32_t destination, float gain = 1.0f)
+	{
+		if (numConnections >= kMaxGraphConnections || !isSourceNode(source) || !isDestinationNode(destination))
+			return false;
+
+		connections[numConnections++] = GraphConnection(source, destination, gain);
+		compiled = false;
+		return true;
+	}
+
+	/** turn the description into a flat execution list */
+	/**
+	\return false if the connections form a cycle or the arena has fewer than getNumBlockBuffers( ) buffers; the output
+	is then silent until the next successful compile( )
+	*/
+	bool compile()
+	{
+		numSteps = 0;
+		numBlockBuffers = 1;
+		compiled = false;
+		outputBuffer = getSilence();
+
+		// --- Kahn's algorithm over the stage nodes, in the order they were added
+		uint32_t pendingInputs[kMaxGraphStages + 1] = { 0 };
+		bool scheduled[kMaxGraphStages + 1] = { false };
+		for (uint32_t c = 0; c < numConnections; c++)
+		{
+			if (connections[c].destination != kGraphOutput && connections[c].source != kGraphInput)
+				pendingInputs[connections[c].destination]++;
+		}
+
+		nodeBuffer[kGraphInput] = getInputBuffer();
+		for (uint32_t scheduledCount = 0; scheduledCount < numStages; scheduledCount++)
+		{
+			uint32_t node = 0;
+			for (uint32_t n = 1; n <= numStages && node == 0; n++)
+			{
+				if (!scheduled[n] && pendingInputs[n] == 0)
+					node = n;
+			}
+
+			// --- cycle
+			if (node == 0)
+				return false;
+
+			scheduled[node] = true;
+			if (!addMixStep(node))
+				return false;
+
+			GraphStep& step = steps[numSteps++];
+			step.type = graphStepType::kProcess;
+			step.stage = stages[node - 1];
+			step.node = node;
+			step.input = nodeBuffer[node];
+			step.output = takeBlockBuffer();
+			nodeBuffer[node] = step.output;
+
+			for (uint32_t c = 0; c < numConnections; c++)
+			{
+				if (connections[c].source == node && connections[c].destination != kGraphOutput)
+					pendingInputs[connections[c].destination]--;
+			}
+		}
+
+		if (!addMixStep(kGraphOutput))
+			return false;
+
+		// --- every buffer was counted; run only if the arena really has them all
+		if (!arena || numBlockBuffers > arena->getNumBuffers())
+		{
+			numSteps = 0;
+			return false;
+		}
+
+		outputBuffer = nodeBuffer[kGraphOutput];
+		compiled = true;
+		return true;
+	}
+
+	/** \return true if compile( ) succeeded since the last change to the description */
+	bool isCompiled() { return compiled; }
+
+	/** \return the block buffers (input included) the last compile( ) needed, successful or not */
+	uint32_t getNumBlockBuffers() { return numBlockBuffers; }
+
+	/** \return the interleaved input block to fill before process( ) (arena buffer 0), or nullptr without an arena */
+	SampleType* getInputBuffer() { return arena ? arena->template getBuffer<SampleType>(0) : nullptr; }
+
+	/** interleave host channel buffers into the input block, one pass per block; a missing right channel reads as silence */
+	/**
+	\param channels the host's channel buffers
+	\param numChannels number of host channels (only the first kGraphChannels are used)
+	\param startFrame first frame to read
+	\param numFrames frames to read, up to kGraphBlockFrames
+	*/
+	void writeInputBlock(SampleType** channels, uint32_t numChannels, uint32_t startFrame, uint32_t numFrames)
+	{
+		if (numFrames > kGraphBlockFrames)
+			numFrames = kGraphBlockFrames;
+
+		SampleType* interleaved = getInputBuffer();
+		if (!interleaved)
+			return;
+
+		if (numChannels >= 2)
+		{
+			const SampleType* left = channels[0] + startFrame;
+			const SampleType* right = channels[1] + startFrame;
+			for (uint32_t n = 0; n < numFrames; n++)
+			{
+				interleaved[2 * n] = left[n];
+				interleaved[2 * n + 1] = right[n];
+			}
+		}
+		else if (numChannels == 1)
+		{
+			const SampleType* mono = channels[0] + startFrame;
+			for (uint32_t n = 0; n < numFrames; n++)
+			{
+				interleaved[2 * n] = mono[n];
+				interleaved[2 * n + 1] = 0;
+			}
+		}
+		else
+			memset(interleaved, 0, sizeof(SampleType)*numFrames*kGraphChannels);
+	}
+
+	/** deinterleave the result of the last process( ) into host channel buffers, one pass per block */
+	/**
+	\param channels the host's channel buffers
+	\param numChannels number of host channels (only the first kGraphChannels are written)
+	\param startFrame first frame to write
+	\param numFrames frames to write, up to kGraphBlockFrames
+	\param monoResult true if the graph ran mono (see process( )): the left channel is fanned out to every output
+	*/
+	void readOutputBlock(SampleType** channels, uint32_t numChannels, uint32_t startFrame, uint32_t numFrames, bool monoResult)
+	{
+		if (numFrames > kGraphBlockFrames)
+			numFrames = kGraphBlockFrames;
+
+		const SampleType* interleaved = outputBuffer;
+		if (numChannels >= 2 && !monoResult)
+		{
+			SampleType* left = channels[0] + startFrame;
+			SampleType* right = channels[1] + startFrame;
+			for (uint32_t n = 0; n < numFrames; n++)
+			{
+				left[n] = interleaved[2 * n];
+				right[n] = interleaved[2 * n + 1];
+			}
+		}
+		else if (numChannels >= 1)
+		{
+			SampleType* mono = channels[0] + startFrame;
+			for (uint32_t n = 0; n < numFrames; n++)
+				mono[n] = interleaved[2 * n];
+
+			for (uint32_t i = 1; i < numChannels && i < kGraphChannels; i++)
+				memcpy(channels[i] + startFrame, mono, sizeof(SampleType)*numFrames);
+		}
+	}
+
+	/** run the execution list over one block */
+	/**
+	\param numFrames frames in the block, up to kGraphBlockFrames
+	\param inputChannels channel count passed to every stage (as in frame processing)
+	\param outputChannels channel count passed to every stage; the graph zeroes the channels a stage leaves unwritten
+	       (all of them if it does not handle the format), since buffers are shared with other topologies and the
+	       other sample format
+	\return the interleaved output block
+	*/
+	const SampleType* process(uint32_t numFrames, uint32_t inputChannels, uint32_t outputChannels)
+	{
+		if (numFrames > kGraphBlockFrames)
+			numFrames = kGraphBlockFrames;
+
+		for (uint32_t s = 0; s < numSteps; s++)
+		{
+			PROFILE_STAGE_BEGIN(step);
+			const GraphStep& step = steps[s];
+			if (step.type == graphStepType::kMix)
+			{
+				// --- accumulate in double so a 0.5/0.5 mix rounds once, like 0.5 * (a + b)
+				uint32_t numSamples = numFrames*kGraphChannels;
+				for (uint32_t i = 0; i < numSamples; i++)
+				{
+					double sum = 0.0;
+					for (uint32_t k = 0; k < step.numSources; k++)
+						sum += step.sourceGain[k] * step.sources[k][i];
+					step.output[i] = (SampleType)sum;
+				}
+			}
+			else
+			{
+				// --- a stage that does not handle the channel format passes silence
+				uint32_t writtenChannels = outputChannels;
+				if (!processStageBlock(step.stage, step.input, step.output, numFrames, inputChannels, outputChannels))
+					writtenChannels = 0;
+
+				for (uint32_t channel = writtenChannels; channel < kGraphChannels; channel++)
+				{
+					for (uint32_t n = 0; n < numFrames; n++)
+						step.output[n*kGraphChannels + channel] = 0;
+				}
+			}
+#ifdef ENABLE_STAGE_PROFILING
+			if (profiler)
+				profiler->addStageSpan(profiledStage[step.node], stepStartTime, StageProfiler::now(), numFrames);
+#endif
+		}
+		return outputBuffer;
+	}
+
+#ifdef ENABLE_STAGE_PROFILING
+	/** time every step into a profiler; mix steps count as mixStage */
+	/**
+	\param _profiler the profiler, or nullptr to stop timing
+	\param mixStage profiledStage of the mix steps
+	*/
+	void setProfiler(StageProfiler* _profiler, uint32_t mixStage)
+	{
+		profiler = _profiler;
+		profiledStage[kGraphOutput] = mixStage;
+	}
+
+	/** set the profiledStage a stage node's processing counts as (cleared by clear( )) */
+	void setProfiledStage(uint32_t node, uint32_t stage)
+	{
+		if (node >= 1 && node <= kMaxGraphStages)
+			profiledStage[node] = stage;
+	}
+#endif
+
+private:
+	enum class graphStepType { kMix, kProcess };
+
+	struct GraphStep
+	{
+		graphStepType type = graphStepType::kProcess;
+		IAudioSignalProcessor* stage = nullptr;			///< kProcess: the stage
+		const SampleType* input = nullptr;					///< kProcess: input block
+		SampleType* output = nullptr;						///< output block
+		const SampleType* sources[kMaxGraphConnections];		///< kMix: source blocks
+		double sourceGain[kMaxGraphConnections];		///< kMix: source weights
+		uint32_t numSources = 0;						///< kMix: number of sources
+		uint32_t node = kGraphOutput;					///< kProcess: the stage's node; kMix: kGraphOutput (profiling)
+	};
+
+	/** one block through a stage, in the graph's sample format; one virtual call per block */
+	static bool processStageBlock(IAudioSignalProcessor* stage, const float* input, float* output, uint32_t numFrames, uint32_t inputChannels, uint32_t outputChannels)
+	{
+		return stage->processAudioFrames(input, output, numFrames, kGraphChannels, inputChannels, outputChannels);
+	}
+	static bool processStageBlock(IAudioSignalProcessor* stage, const double* input, double* output, uint32_t numFrames, uint32_t inputChannels, uint32_t outputChannels)
+	{
+		return stage->processAudioFrames64(input, output, numFrames, kGraphChannels, inputChannels, outputChannels);
+	}
+
+	/** one read-only block of silence for the whole module, for nodes with no sources */
+	static const SampleType* getSilence()
+	{
+		static const SampleType silence[kGraphBlockSamples] = { 0 };
+		return silence;
+	}
+
+	/** the next arena buffer for a stage output or mix; counts it even when the arena is too small (see compile( )) */
+	SampleType* takeBlockBuffer()
+	{
+		SampleType* buffer = arena ? arena->template getBuffer<SampleType>(numBlockBuffers) : nullptr;
+		numBlockBuffers++;
+		return buffer;
+	}
+
+	bool isSourceNode(uint32_t node) { return node == kGraphInput || (node >= 1 && node <= numStages); }
+	bool isDestinationNode(uint32_t node) { return node == kGraphOutput || (node >= 1 && node <= numStages); }
+
+	/** point nodeBuffer[node] at its input: a source buffer directly, a mix step into a new buffer, or silence */
+	bool addMixStep(uint32_t node)
+	{
+		uint32_t numSources = 0;
+		uint32_t lastSource = 0;
+		bool unity = true;
+		for (uint32_t c = 0; c < numConnections; c++)
+		{
+			if (connections[c].destination == node)
+			{
+				numSources++;
+				lastSource = c;
+				unity = unity && connections[c].gain == 1.0f;
+			}
+		}
+
+		if (numSources == 0)
+		{
+			nodeBuffer[node] = getSilence();
+			return true;
+		}
+		if (numSources == 1 && unity)
+		{
+			nodeBuffer[node] = nodeBuffer[connections[lastSource].source];
+			return true;
+		}
+		if (numSteps >= kMaxGraphSteps)
+			return false;
+
+		GraphStep& step = steps[numSteps++];
+		step.type = graphStepType::kMix;
+		step.node = kGraphOutput;
+		step.output = takeBlockBuffer();
+		step.numSources = 0;
+		for (uint32_t c = 0; c < numConnections; c++)
+		{
+			if (connections[c].destination == node)
+			{
+				step.sources[step.numSources] = nodeBuffer[connections[c].source];
+				step.sourceGain[step.numSources++] = connections[c].gain;
+			}
+		}
+		nodeBuffer[node] = step.output;
+		return true;
+	}
+
+	static const uint32_t kMaxGraphSteps = 2 * kMaxGraphStages + 1;	///< one mix + one process per stage, one output mix
+
+	// --- description
+	IAudioSignalProcessor* stages[kMaxGraphStages];
+	uint32_t numStages = 0;
+	GraphConnection connections[kMaxGraphConnections];
+	uint32_t numConnections = 0;
+
+	// --- compiled form
+	GraphStep steps[kMaxGraphSteps];
+	uint32_t numSteps = 0;
+	bool compiled = false;
+	const SampleType* nodeBuffer[kMaxGraphStages + 2];	///< block each node's consumers read (input, stages, output)
+	const SampleType* outputBuffer = nullptr;			///< graph result
+	GraphBlockArena* arena = nullptr;					///< block buffers, shared with the instance's other graph
+	uint32_t numBlockBuffers = 1;						///< buffers the compiled form uses, input included
+
+#ifdef ENABLE_STAGE_PROFILING
+	StageProfiler* profiler = nullptr;							///< step timing, if set
+	uint32_t profiledStage[kGraphOutput + 1] = { 0 };			///< profiledStage per node; kGraphOutput holds the mix stage
+#endif
+};
+
+typedef SampleProcessingGraph<float> ProcessingGraph;		///< float blocks, processAudioFrame( )
+typedef SampleProcessingGraph<double> ProcessingGraph64;	///< double blocks, processAudioFrame64( )
+
+#endif
@@ -0,0 +1,610 @@
+#pragma once
+
+#ifndef __StaticFXObjects__
+#define __StaticFXObjects__
+
+#include "fxobjects.h"
+
+/** @file staticfxobjects.h
+\brief statically composed (non-virtual) versions of the fxobjects used in the per-sample
+call chain of the plugin: Biquad -> AudioFilter -> LRFilterBank and AudioDetector -> EnvelopeFollower
+
+- the objects here do NOT derive from IAudioSignalProcessor; every processing function is an
+  inline, non-virtual member so that the compiler can flatten the whole chain into the caller
+- they expose the same get/setParameters( ) interfaces and use the same parameter structures
+  as their fxobjects.h counterparts, and produce bit-identical output
+- use SignalProcessorAdaptor<> to hand one of these to code that requires an IAudioSignalProcessor
+*/
+
+/**
+\class SignalProcessorAdaptor
+\ingroup FX-Objects
+\brief
+Wraps a statically composed DSP object so it can be used anywhere an IAudioSignalProcessor is required.
+The virtual dispatch happens once at the adaptor; all calls from the adaptor into the wrapped object
+(and below it) are resolved at compile time.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <class DSPObject>
+class SignalProcessorAdaptor : public IAudioSignalProcessor
+{
+public:
+	SignalProcessorAdaptor() {}		/* C-TOR */
+	~SignalProcessorAdaptor() {}	/* D-TOR */
+
+	/** reset the wrapped object */
+	virtual bool reset(double _sampleRate) { return object.reset(_sampleRate); }
+
+	/** process one sample through the wrapped object */
+	virtual double processAudioSample(double xn) { return object.processAudioSample(xn); }
+
+	/** return false: the static objects only process samples */
+	virtual bool canProcessAudioFrame() { return false; }
+
+	/** access to the wrapped object for get/setParameters( ) */
+	DSPObject& getObject() { return object; }
+
+protected:
+	DSPObject object; ///< the statically composed object
+};
+
+/**
+\class StaticBiquad
+\ingroup FX-Objects
+\brief
+Non-virtual Biquad; the calculation structure is a template argument rather than a runtime parameter
+so the structure branch is resolved at compile time.
+
+Supports biquadAlgorithm::kDirect (the default, matching AudioFilter) and biquadAlgorithm::kTransposeCanonical.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <biquadAlgorithm algorithm = biquadAlgorithm::kDirect>
+class StaticBiquad
+{
+	static_assert(algorithm == biquadAlgorithm::kDirect || algorithm == biquadAlgorithm::kTransposeCanonical,
+		"StaticBiquad supports the kDirect and kTransposeCanonical structures");
+
+public:
+	StaticBiquad() {}	/* C-TOR */
+	~StaticBiquad() {}	/* D-TOR */
+
+	/** reset: clear out the state array (flush delays) */
+	inline bool reset(double _sampleRate)
+	{
+		memset(&stateArray[0], 0, sizeof(double)*numStates);
+		return true;
+	}
+
+	/** process input x(n) through biquad to produce return value y(n); see Biquad::processAudioSample( ) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	inline double processAudioSample(double xn)
+	{
+		if (algorithm == biquadAlgorithm::kDirect)
+		{
+			// --- 1)  form output y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
+			storageComponent = coeffArray[a1] * stateArray[x_z1] +
+							   coeffArray[a2] * stateArray[x_z2] -
+							   coeffArray[b1] * stateArray[y_z1] -
+							   coeffArray[b2] * stateArray[y_z2];
+
+			double yn = coeffArray[a0] * xn + storageComponent;
+
+			// --- 2) underflow check
+			checkFloatUnderflow(yn);
+
+			// --- 3) update states
+			stateArray[x_z2] = stateArray[x_z1];
+			stateArray[x_z1] = xn;
+
+			stateArray[y_z2] = stateArray[y_z1];
+			stateArray[y_z1] = yn;
+
+			return yn;
+		}
+
+		// --- kTransposeCanonical
+		storageComponent = stateArray[x_z1];
+
+		// --- 1)  form output y(n) = a0*x(n) + stateArray[x_z1]
+		double yn = coeffArray[a0] * xn + stateArray[x_z1];
+
+		// --- 2) underflow check
+		checkFloatUnderflow(yn);
+
+		// --- 3) shuffle/update
+		stateArray[x_z1] = coeffArray[a1] * xn - coeffArray[b1] * yn + stateArray[x_z2];
+		stateArray[x_z2] = coeffArray[a2] * xn - coeffArray[b2] * yn;
+
+		return yn;
+	}
+
+	/** set the coefficient array */
+	inline void setCoefficients(const double* coeffs)
+	{
+		memcpy(&coeffArray[0], &coeffs[0], sizeof(double)*numCoeffs);
+	}
+
+	/** get the coefficient array */
+	double* getCoefficients() { return &coeffArray[0]; }
+
+	/** get the state array */
+	double* getStateArray() { return &stateArray[0]; }
+
+	/** get the structure G (gain) value for Harma filters */
+	double getG_value() { return coeffArray[a0]; }
+
+	/** get the structure S (storage) value for Harma filters */
+	double getS_value() { return storageComponent; }
+
+protected:
+	double coeffArray[numCoeffs] = { 0.0 };	///< array of coefficients
+	double stateArray[numStates] = { 0.0 };	///< array of state (z^-1) registers
+	double storageComponent = 0.0;			///< for Harma loop resolution
+};
+
+/**
+\class StaticAudioFilter
+\ingroup FX-Objects
+\brief
+Non-virtual AudioFilter; shares its coefficient calculation with AudioFilter via calculateAudioFilterCoeffs( ).
+
+Control I/F:
+- Use AudioFilterParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <biquadAlgorithm algorithm = biquadAlgorithm::kDirect>
+class StaticAudioFilter
+{
+public:
+	StaticAudioFilter() {}		/* C-TOR */
+	~StaticAudioFilter() {}		/* D-TOR */
+
+	/** --- set sample rate and flush the biquad; coefficients are NOT recalculated (same as AudioFilter) */
+	inline bool reset(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		return biquad.reset(_sampleRate);
+	}
+
+	/** process input x(n) through the filter: return (dry) + (processed): x(n)*d0 + y(n)*c0 */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	inline double processAudioSample(double xn)
+	{
+		return coeffArray[d0] * xn + coeffArray[c0] * biquad.processAudioSample(xn);
+	}
+
+	/** --- sample rate change necessarily requires recalculation */
+	inline void setSampleRate(double _sampleRate)
+	{
+		sampleRate = _sampleRate;
+		calculateFilterCoeffs();
+	}
+
+	/** --- get parameters */
+	AudioFilterParameters getParameters() { return audioFilterParameters; }
+
+	/** --- copy the coefficient array (numCoeffs long) */
+	bool getCoefficients(double* coeffs)
+	{
+		memcpy(&coeffs[0], &coeffArray[0], sizeof(double)*numCoeffs);
+		return true;
+	}
+
+	/** --- set parameters; coefficients are only recalculated when something changed */
+	inline void setParameters(const AudioFilterParameters& parameters)
+	{
+		if (audioFilterParameters.algorithm == parameters.algorithm &&
+			audioFilterParameters.boostCut_dB == parameters.boostCut_dB &&
+			audioFilterParameters.fc == parameters.fc &&
+			audioFilterParameters.Q == parameters.Q)
+			return;
+
+		// --- save new params
+		audioFilterParameters = parameters;
+
+		// --- don't allow 0 or (-) values for Q
+		if (audioFilterParameters.Q <= 0)
+			audioFilterParameters.Q = 0.707;
+
+		// --- update coeffs
+		calculateFilterCoeffs();
+	}
+
+	/** --- helper for Harma filters (phaser) */
+	double getG_value() { return biquad.getG_value(); }
+
+	/** --- helper for Harma filters (phaser) */
+	double getS_value() { return biquad.getS_value(); }
+
+protected:
+	StaticBiquad<algorithm> biquad;				///< the biquad object
+	double coeffArray[numCoeffs] = { 0.0 };		///< our local copy of biquad coeffs
+	AudioFilterParameters audioFilterParameters;///< parameters
+	double sampleRate = 44100.0;				///< current sample rate
+
+	/** --- recalculate coefficients due to a change in filter parameters */
+	bool calculateFilterCoeffs()
+	{
+		if (!calculateAudioFilterCoeffs(audioFilterParameters, sampleRate, coeffArray))
+			return false;
+
+		biquad.setCoefficients(coeffArray);
+		return true;
+	}
+};
+
+/**
+\class StaticLRFilterBank
+\ingroup FX-Objects
+\brief
+Non-virtual LRFilterBank: 2 Linkwitz-Riley filters in a parallel bank, HF output inverted.
+
+Control I/F:
+- Use LRFilterBankParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <class FilterType = StaticAudioFilter<>>
+class StaticLRFilterBank
+{
+public:
+	StaticLRFilterBank()		/* C-TOR */
+	{
+		// --- set filters as Linkwitz-Riley 2nd order
+		AudioFilterParameters params = lpFilter.getParameters();
+		params.algorithm = filterAlgorithm::kLWRLPF2;
+		lpFilter.setParameters(params);
+
+		params = hpFilter.getParameters();
+		params.algorithm = filterAlgorithm::kLWRHPF2;
+		hpFilter.setParameters(params);
+	}
+	~StaticLRFilterBank() {}	/* D-TOR */
+
+	/** bind both filters to a state arena (only for arena views, see dspstatearena.h) */
+	template <class ArenaType>
+	bool bindToArena(ArenaType& arena)
+	{
+		return lpFilter.bindToArena(arena) && hpFilter.bindToArena(arena);
+	}
+
+	/** reset member objects */
+	inline bool reset(double _sampleRate)
+	{
+		lpFilter.reset(_sampleRate);
+		hpFilter.reset(_sampleRate);
+		return true;
+	}
+
+	/** process the filter bank */
+	inline FilterBankOutput processFilterBank(double xn)
+	{
+		FilterBankOutput output;
+
+		// --- process the LPF
+		output.LFOut = lpFilter.processAudioSample(xn);
+
+		// --- invert the HP filter output so that recombination will
+		//     result in the correct phase and magnitude responses
+		output.HFOut = -hpFilter.processAudioSample(xn);
+
+		return output;
+	}
+
+	/** get parameters */
+	LRFilterBankParameters getParameters() { return parameters; }
+
+	/** copy both filters' coefficients (numCoeffs each); the HF output is the inverted hpCoeffs response */
+	bool getCoefficients(double* lpCoeffs, double* hpCoeffs)
+	{
+		return lpFilter.getCoefficients(lpCoeffs) && hpFilter.getCoefficients(hpCoeffs);
+	}
+
+	/** set parameters */
+	inline void setParameters(const LRFilterBankParameters& _parameters)
+	{
+		parameters = _parameters;
+
+		AudioFilterParameters params = lpFilter.getParameters();
+		params.fc = parameters.splitFrequency;
+		lpFilter.setParameters(params);
+
+		params = hpFilter.getParameters();
+		params.fc = parameters.splitFrequency;
+		hpFilter.setParameters(params);
+	}
+
+protected:
+	FilterType lpFilter; ///< low-band filter
+	FilterType hpFilter; ///< high-band filter
+
+	LRFilterBankParameters parameters; ///< parameters for the object
+};
+
+/**
+\class StaticAudioDetector
+\ingroup FX-Objects
+\brief
+Non-virtual AudioDetector; see AudioDetector for the detection algorithm.
+
+Control I/F:
+- Use AudioDetectorParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+class StaticAudioDetector
+{
+public:
+	StaticAudioDetector() {}	/* C-TOR */
+	~StaticAudioDetector() {}	/* D-TOR */
+
+	/** set sample rate dependent time constants and clear last envelope output value */
+	inline bool reset(double _sampleRate)
+	{
+		setSampleRate(_sampleRate);
+		lastEnvelope = 0.0;
+		return true;
+	}
+
+	/** detect the envelope; returns dB when detect_dB is set */
+	/**
+	\param xn input
+	\return the detected value
+	*/
+	inline double processAudioSample(double xn)
+	{
+		// --- all modes do Full Wave Rectification
+		double input = fabs(xn);
+
+		// --- square it for MS and RMS
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_MS ||
+			audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			input *= input;
+
+		// --- do the detection with attack or release applied
+		double currEnvelope = 0.0;
+		if (input > lastEnvelope)
+			currEnvelope = attackTime * (lastEnvelope - input) + input;
+		else
+			currEnvelope = releaseTime * (lastEnvelope - input) + input;
+
+		// --- we are recursive so need to check underflow
+		checkFloatUnderflow(currEnvelope);
+
+		// --- bound them; can happen when using pre-detector gains of more than 1.0
+		if (audioDetectorParameters.clampToUnityMax)
+			currEnvelope = fmin(currEnvelope, 1.0);
+
+		// --- can not be (-)
+		currEnvelope = fmax(currEnvelope, 0.0);
+
+		// --- store envelope prior to sqrt for RMS version
+		lastEnvelope = currEnvelope;
+
+		// --- if RMS, do the SQRT
+		if (audioDetectorParameters.detectMode == TLD_AUDIO_DETECT_MODE_RMS)
+			currEnvelope = pow(currEnvelope, 0.5);
+
+		// --- if not dB, we are done
+		if (!audioDetectorParameters.detect_dB)
+			return currEnvelope;
+
+		if (currEnvelope <= 0)
+			return -96.0;
+
+		// --- true log output in dB, can go above 0dBFS!
+		return raw2dBFast(currEnvelope);
+	}
+
+	/** get parameters */
+	AudioDetectorParameters getParameters() { return audioDetectorParameters; }
+
+	/** set parameters */
+	inline void setParameters(const AudioDetectorParameters& parameters)
+	{
+		audioDetectorParameters = parameters;
+
+		setAttackTime(audioDetectorParameters.attackTime_mSec, true);
+		setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+	}
+
+	/** set sample rate - our time constants depend on it */
+	inline void setSampleRate(double _sampleRate)
+	{
+		if (sampleRate == _sampleRate)
+			return;
+
+		sampleRate = _sampleRate;
+
+		setAttackTime(audioDetectorParameters.attackTime_mSec, true);
+		setReleaseTime(audioDetectorParameters.releaseTime_mSec, true);
+	}
+
+protected:
+	AudioDetectorParameters audioDetectorParameters; ///< parameters for object
+	double attackTime = 0.0;	///< attack time coefficient
+	double releaseTime = 0.0;	///< release time coefficient
+	double sampleRate = 44100;	///< stored sample rate
+	double lastEnvelope = 0.0;	///< output register
+
+	/** set our internal atack time coefficients based on times and sample rate */
+	void setAttackTime(double attack_in_ms, bool forceCalc = false)
+	{
+		if (!forceCalc && audioDetectorParameters.attackTime_mSec == attack_in_ms)
+			return;
+
+		audioDetectorParameters.attackTime_mSec = attack_in_ms;
+		attackTime = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (attack_in_ms * sampleRate * 0.001));
+	}
+
+	/** set our internal release time coefficients based on times and sample rate */
+	void setReleaseTime(double release_in_ms, bool forceCalc = false)
+	{
+		if (!forceCalc && audioDetectorParameters.releaseTime_mSec == release_in_ms)
+			return;
+
+		audioDetectorParameters.releaseTime_mSec = release_in_ms;
+		releaseTime = exp(TLD_AUDIO_ENVELOPE_ANALOG_TC / (release_in_ms * sampleRate * 0.001));
+	}
+};
+
+/**
+\class StaticEnvelopeFollower
+\ingroup FX-Objects
+\brief
+Non-virtual EnvelopeFollower (with the invert/LFO-threshold additions) modulating the fc of its filter
+with the detected input strength.
+
+Control I/F:
+- Use EnvelopeFollowerParameters structure to get/set object params.
+
+\author Christian George
+\version Revision : 1.0
+\date Date : 2019 / 06 / 01
+*/
+template <class FilterType = StaticAudioFilter<>, class DetectorType = StaticAudioDetector>
+class StaticEnvelopeFollower
+{
+public:
+	StaticEnvelopeFollower()		/* C-TOR */
+	{
+		// --- setup the filter
+		AudioFilterParameters filterParams;
+		filterParams.algorithm = filterAlgorithm::kMMALPF2;
+		filter.setParameters(filterParams);
+
+		// --- setup the detector
+		AudioDetectorParameters adParams;
+		adParams.attackTime_mSec = -1.0;
+		adParams.releaseTime_mSec = -1.0;
+		adParams.detectMode = TLD_AUDIO_DETECT_MODE_RMS;
+		adParams.detect_dB = true;
+		adParams.clampToUnityMax = false;
+		detector.setParameters(adParams);
+	}
+	~StaticEnvelopeFollower() {}	/* D-TOR */
+
+	/** bind the filter and detector to a state arena (only for arena views, see dspstatearena.h) */
+	template <class ArenaType>
+	bool bindToArena(ArenaType& arena)
+	{
+		return filter.bindToArena(arena) && detector.bindToArena(arena);
+	}
+
+	/** reset members to initialized state */
+	inline bool reset(double _sampleRate)
+	{
+		filter.reset(_sampleRate);
+		detector.reset(_sampleRate);
+		return true;
+	}
+
+	/** get parameters */
+	EnvelopeFollowerParameters getParameters() { return parameters; }
+
+	/** copy the filter's current (modulated) coefficients, numCoeffs long */
+	bool getFilterCoefficients(double* coeffs) { return filter.getCoefficients(coeffs); }
+
+	/** \return the filter's current (modulated) cutoff in Hz */
+	double getFilterFc() { return filter.getParameters().fc; }
+
+	/** set parameters */
+	inline void setParameters(const EnvelopeFollowerParameters& params)
+	{
+		// --- audiofilter parameters
+		if (params.fc != parameters.fc || params.Q != parameters.Q ||
+			params.filterType != parameters.filterType)
+		{
+			AudioFilterParameters filterParams = filter.getParameters();
+			filterParams.fc = params.fc;
+			filterParams.Q = params.Q;
+			filterParams.algorithm = params.filterType;
+			filter.setParameters(filterParams);
+		}
+
+		// --- audio detector parameters
+		if (params.attackTime_mSec != parameters.attackTime_mSec ||
+			params.releaseTime_mSec != parameters.releaseTime_mSec)
+		{
+			AudioDetectorParameters adParams = detector.getParameters();
+			adParams.attackTime_mSec = params.attackTime_mSec;
+			adParams.releaseTime_mSec = params.releaseTime_mSec;
+			detector.setParameters(adParams);
+		}
+
+		// --- save
+		parameters = params;
+	}
+
+	/** process input x(n) through the envelope follower to produce return value y(n) */
+	/**
+	\param xn input
+	\return the processed sample
+	*/
+	inline double processAudioSample(double xn)
+	{
+		// --- calc threshold
+		double threshValue = dB2RawFast(parameters.threshold_dB);
+
+		// --- detect the signal
+		double detect_dB = detector.processAudioSample(xn);
+		double detectValue = dB2RawFast(detect_dB);
+		double deltaValue = detectValue - threshValue;
+
+		AudioFilterParameters filterParams = filter.getParameters();
+
+		if (parameters.invertModulation)
+			filterParams.fc = 20e3;
+		else
+			filterParams.fc = parameters.fc;
+
+		// --- if above the threshold, modulate the filter fc
+		if (deltaValue > 0.0)
+		{
+			double modulatorValue = (deltaValue * parameters.sensitivity);
+
+			// --- lfo threshold
+			if (parameters.enableLFOThreshold)
+				filterParams.fc = parameters.fc + parameters.lfoModifier;
+
+			// --- calculate modulated frequency, check inversion
+			else if (parameters.invertModulation)
+				filterParams.fc = doUnipolarModulationFromMax(1 - modulatorValue, parameters.fc, 20e3);
+			else
+				filterParams.fc = doUnipolarModulationFromMin(modulatorValue, parameters.fc, kMaxFilterFrequency);
+		}
+
+		// --- update with new modulated frequency
+		filter.setParameters(filterParams);
+
+		// --- perform the filtering operation
+		return filter.processAudioSample(xn);
+	}
+
+protected:
+	EnvelopeFollowerParameters parameters; ///< object parameters
+
+	FilterType filter;		///< filter to modulate
+	DetectorType detector;	///< detector to track input signal
+};
+
+#endif
@@ -272,13 +272,17 @@ void Rafx2Plugin::setParameterByIndex(uint32_t index, double actualValue)
 void Rafx2Plugin::setParameterNormalizedByControlID(uint32_t controlID, double normalizedValue)
 {
 	if (!pluginCore) return;
-	pluginCore->getPluginParameterByControlID(controlID)->setControlValueNormalized(normalizedValue);
+	PluginParameter* piParam = pluginCore->getPluginParameterByControlID(controlID);
+	if (!piParam) return;
+	piParam->setControlValueNormalized(normalizedValue);
 }
 
 void Rafx2Plugin::setParameterByControlID(uint32_t controlID, double actualValue)
 {
 	if (!pluginCore) return;
-	pluginCore->getPluginParameterByControlID(controlID)->setControlValue(actualValue);
+	PluginParameter* piParam = pluginCore->getPluginParameterByControlID(controlID);
+	if (!piParam) return;
+	piParam->setControlValue(actualValue);
 }
 
 double Rafx2Plugin::getParameterNormalizedByIndex(uint32_t index)
@@ -296,25 +300,31 @@ double Rafx2Plugin::getParameterByIndex(uint32_t index)
 double Rafx2Plugin::getParameterNormalizedByControlID(uint32_t controlID)
 {
 	if (!pluginCore) return 0.0;
-	return pluginCore->getPluginParameterByControlID(controlID)->getControlValueNormalized();
+	PluginParameter* piParam = pluginCore->getPluginParameterByControlID(controlID);
+	if (!piParam) return 0.0;
+	return piParam->getControlValueNormalized();
 }
 
 double Rafx2Plugin::getParameterByControlID(uint32_t controlID)
 {
 	if (!pluginCore) return 0.0;
-	return pluginCore->getPluginParameterByControlID(controlID)->getControlValue();
+	PluginParameter* piParam = pluginCore->getPluginParameterByControlID(controlID);
+	if (!piParam) return 0.0;
+	return piParam->getControlValue();
 }
 
-AuxParameterAttribute* Rafx2Plugin::getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID)
+const AuxParameterAttribute* Rafx2Plugin::getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID)
 {
 	if (!pluginCore) return nullptr;
 	return pluginCore->getPluginParameterByIndex(index)->getAuxAttribute(attributeID);
 }
 
-AuxParameterAttribute* Rafx2Plugin::getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID)
+const AuxParameterAttribute* Rafx2Plugin::getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID)
 {
 	if (!pluginCore) return nullptr;
-	return pluginCore->getPluginParameterByControlID(controlID)->getAuxAttribute(attributeID);
+	PluginParameter* piParam = pluginCore->getPluginParameterByControlID(controlID);
+	if (!piParam) return nullptr;
+	return piParam->getAuxAttribute(attributeID);
 }
 
 uint32_t Rafx2Plugin::getDefaultChannelIOConfigForChannelCount(uint32_t channelCount)
@@ -43,8 +43,8 @@ public:
 	virtual void setupTrackPad();
 
 	// --- aux attributes
-	virtual AuxParameterAttribute* getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID);
-	virtual AuxParameterAttribute* getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID);
+	virtual const AuxParameterAttribute* getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID);
+	virtual const AuxParameterAttribute* getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID);
 
 	// --- miscellaneous
 	virtual uint32_t getDefaultChannelIOConfigForChannelCount(uint32_t channelCount);
@@ -84,6 +84,13 @@ public:
 			customViewIF->pushDataValue(data);
 	}
 
+	// --- forward whole blocks; the ICustomView default would split them into one pushDataValue( ) per sample
+	virtual void pushDataBlock(const float* data, uint32_t count)
+	{
+		if (customViewIF)
+			customViewIF->pushDataBlock(data, count);
+	}
+
 	virtual void sendMessage(void* data)
 	{
 		if (customViewIF)
@@ -149,6 +156,15 @@ public:
 		return 0.0;
 	}
 
+	// --- the core's outbound dirty set; without it the GUI falls back to polling every writeable control
+	virtual ControlDirtySet* getOutboundDirtySet()
+	{
+		if (plugin)
+			return plugin->getOutboundDirtySet();
+
+		return nullptr;
+	}
+
 	virtual bool registerSubcontroller(std::string subcontrollerName, ICustomView* customViewConnector)
 	{
 		// --- do we have this in our map already?
@@ -31,8 +31,8 @@ public:
 	virtual double getParameterByIndex(uint32_t index) = 0;
 	virtual double getParameterNormalizedByControlID(uint32_t controlID) = 0;
 	virtual double getParameterByControlID(uint32_t controlID) = 0;
-	virtual AuxParameterAttribute* getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID) = 0;
-	virtual AuxParameterAttribute* getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID) = 0;
+	virtual const AuxParameterAttribute* getAuxParameterAttributeByIndex(uint32_t index, uint32_t attributeID) = 0;
+	virtual const AuxParameterAttribute* getAuxParameterAttributeByControlID(uint32_t controlID, uint32_t attributeID) = 0;
 	virtual uint32_t getDefaultChannelIOConfigForChannelCount(uint32_t channelCount) = 0;
 	virtual bool hasParameterWithIndex(uint32_t index) = 0;
 	virtual bool hasParameterWithControlID(uint32_t controlID) = 0;